@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+#include <signalflow/fft.hpp>
+#include <cmath>
+#include <vector>
+
+// Magnitude spectrum of one windowed frame, per backend and size
+static void BM_FFT(benchmark::State& state, signalflow::FFTBackend backend) {
+    size_t N = static_cast<size_t>(state.range(0));
+    signalflow::FFT fft(N, backend);
+    std::vector<float> frame(N), magnitudes(fft.num_bins());
+    for (size_t i = 0; i < N; ++i) frame[i] = std::sin(0.1f * i) + 0.3f * std::cos(0.77f * i);
+
+    for (auto _ : state) {
+        fft.compute_magnitude(frame, magnitudes);
+        benchmark::DoNotOptimize(magnitudes.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * N * sizeof(float));
+}
+BENCHMARK_CAPTURE(BM_FFT, Kiss, signalflow::FFTBackend::Kiss)->RangeMultiplier(2)->Range(256, 4096);
+BENCHMARK_CAPTURE(BM_FFT, Radix4, signalflow::FFTBackend::Radix4)->RangeMultiplier(2)->Range(256, 4096);
+
+// Constructing an FFT is a plan-cache lookup plus scratch allocation
+static void BM_FFTConstruct(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        signalflow::FFT fft(N, signalflow::FFTBackend::Radix4);
+        benchmark::DoNotOptimize(&fft);
+    }
+}
+BENCHMARK(BM_FFTConstruct)->Arg(1024);
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <signalflow/mel_spectrogram.hpp>
+#include <signalflow/batch.hpp>
+#include <signalflow/stream_engine.hpp>
+#include <memory>
+#include <cmath>
+#include <vector>
+
+// End-to-end throughput. audio_s_per_s is seconds of 16 kHz audio processed per
+// wall-clock second: the headline number for capacity planning.
+
+static constexpr int kSampleRate = 16000;
+static constexpr size_t kSeconds = 10;
+
+static std::vector<float> test_audio() {
+    std::vector<float> x(kSeconds * kSampleRate);
+    for (size_t i = 0; i < x.size(); ++i) x[i] = std::sin(0.05f * i) + 0.1f * std::sin(1.3f * i);
+    return x;
+}
+
+static void set_audio_rate(benchmark::State& state, size_t samples) {
+    state.counters["audio_s_per_s"] = benchmark::Counter(
+        static_cast<double>(samples) / kSampleRate, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Streaming frame loop fed in 10 ms chunks, hop = n_fft / 2
+static void BM_MelSpectrogramStream(benchmark::State& state, signalflow::FFTBackend backend) {
+    size_t N = static_cast<size_t>(state.range(0));
+    size_t n_mels = static_cast<size_t>(state.range(1));
+    signalflow::MelSpectrogram spectrogram(N, N / 2, kSampleRate, n_mels, 0.0f, 8000.0f,
+                                           signalflow::Window::Type::Hann, backend);
+    auto audio = test_audio();
+    constexpr size_t kChunk = kSampleRate / 100;
+    float sink = 0.0f;
+    for (auto _ : state) {
+        spectrogram.reset();
+        for (size_t offset = 0; offset < audio.size(); offset += kChunk) {
+            spectrogram.process(std::span<const float>(audio).subspan(offset, std::min(kChunk, audio.size() - offset)),
+                                [&](std::span<const float> mel) { sink += mel[0]; });
+        }
+    }
+    benchmark::DoNotOptimize(sink);
+    set_audio_rate(state, audio.size());
+}
+BENCHMARK_CAPTURE(BM_MelSpectrogramStream, Kiss, signalflow::FFTBackend::Kiss)
+    ->ArgNames({"n_fft", "n_mels"})
+    ->ArgsProduct({{256, 512, 1024, 2048, 4096}, {40, 128}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_MelSpectrogramStream, Radix4, signalflow::FFTBackend::Radix4)
+    ->ArgNames({"n_fft", "n_mels"})
+    ->ArgsProduct({{256, 512, 1024, 2048, 4096}, {40, 128}})
+    ->Unit(benchmark::kMillisecond);
+
+// Whole-signal batch path on one pool thread, for comparison with the streaming loop.
+// The work happens off the benchmark thread, so rates use wall-clock time.
+static void BM_BatchMelSpectrogram(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    size_t n_mels = static_cast<size_t>(state.range(1));
+    signalflow::BatchMelSpectrogram batch(N, N / 2, kSampleRate, n_mels, 0.0f, 8000.0f,
+                                          signalflow::Window::Type::Hann, 1);
+    auto audio = test_audio();
+    for (auto _ : state) {
+        auto mel = batch.process(audio);
+        benchmark::DoNotOptimize(mel.data.data());
+    }
+    set_audio_rate(state, audio.size());
+}
+BENCHMARK(BM_BatchMelSpectrogram)
+    ->ArgNames({"n_fft", "n_mels"})
+    ->ArgsProduct({{512, 1024}, {40, 128}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Many concurrent sensor streams, each receiving 10 ms per tick, n_fft 512 / hop 160,
+// with normalised log-mel. Independent chains is one MelSpectrogram per stream (each
+// with its own window and filterbank tables); the engine shares them and batches frames.
+// Both run one second of audio per stream, the engine on a single pool thread.
+static constexpr size_t kTick = kSampleRate / 100;
+
+static signalflow::LogMelOptions stream_log_mel() {
+    signalflow::LogMelOptions options;
+    options.normalize = true;
+    return options;
+}
+
+static void BM_IndependentChains(benchmark::State& state) {
+    size_t streams = static_cast<size_t>(state.range(0));
+    std::vector<std::unique_ptr<signalflow::MelSpectrogram>> chains;
+    for (size_t s = 0; s < streams; ++s) {
+        chains.push_back(std::make_unique<signalflow::MelSpectrogram>(
+            512, 160, kSampleRate, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+            signalflow::FFTBackend::Radix4, stream_log_mel()));
+    }
+    auto audio = test_audio();
+    float sink = 0.0f;
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < kSampleRate; offset += kTick) {
+            auto tick = std::span<const float>(audio).subspan(offset, kTick);
+            for (auto& chain : chains) chain->process(tick, [&](std::span<const float> mel) { sink += mel[0]; });
+        }
+    }
+    benchmark::DoNotOptimize(sink);
+    set_audio_rate(state, streams * kSampleRate);
+}
+BENCHMARK(BM_IndependentChains)->ArgNames({"streams"})->Arg(16)->Arg(256)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+static void BM_StreamEngine(benchmark::State& state) {
+    size_t streams = static_cast<size_t>(state.range(0));
+    signalflow::StreamEngine engine(512, 160, kSampleRate, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann, 1,
+                                    signalflow::FFTBackend::Radix4, stream_log_mel());
+    std::vector<signalflow::StreamEngine::StreamId> ids;
+    for (size_t s = 0; s < streams; ++s) ids.push_back(engine.add_stream());
+    auto audio = test_audio();
+    std::vector<float> sinks(streams, 0.0f);
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < kSampleRate; offset += kTick) {
+            auto tick = std::span<const float>(audio).subspan(offset, kTick);
+            for (auto id : ids) engine.push(id, tick);
+            engine.process([&](signalflow::StreamEngine::StreamId id, std::span<const float> mel) { sinks[id] += mel[0]; });
+        }
+    }
+    benchmark::DoNotOptimize(sinks.data());
+    set_audio_rate(state, streams * kSampleRate);
+    state.counters["bytes_per_stream"] = static_cast<double>(engine.stream_state_bytes());
+}
+BENCHMARK(BM_StreamEngine)->ArgNames({"streams"})->Arg(16)->Arg(256)->Arg(2048)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <signalflow/spsc_ring.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Capture-callback -> DSP-thread handoff. The ping-pong benchmarks bounce one hop of
+// samples to a worker thread and back, so time per iteration is two handoffs; the
+// mutex variant models the old lock-wrapped buffer. Spinning sides yield, so on a
+// machine with fewer cores than threads this mostly measures the scheduler.
+
+namespace {
+
+// Move exactly data.size() values, retrying while the ring is full (write) or empty (read)
+template <typename Write>
+void write_all(std::span<const float> data, Write&& write) {
+    while (!data.empty()) {
+        size_t n = write(data);
+        data = data.subspan(n);
+        if (n == 0) std::this_thread::yield();
+    }
+}
+
+template <typename Read>
+void read_all(std::span<float> data, Read&& read) {
+    while (!data.empty()) {
+        size_t n = read(data);
+        data = data.subspan(n);
+        if (n == 0) std::this_thread::yield();
+    }
+}
+
+template <bool Locked>
+void ping_pong(benchmark::State& state) {
+    size_t hop = static_cast<size_t>(state.range(0));
+    signalflow::SpscRing<float> to_worker(4 * hop), to_main(4 * hop);
+    std::mutex lock_to_worker, lock_to_main;
+    std::atomic<bool> stop{false};
+
+    auto writer = [](signalflow::SpscRing<float>& ring, std::mutex& m) {
+        return [&ring, &m](std::span<const float> values) {
+            if constexpr (Locked) {
+                std::lock_guard guard(m);
+                return ring.write(values);
+            } else {
+                return ring.write(values);
+            }
+        };
+    };
+    auto reader = [](signalflow::SpscRing<float>& ring, std::mutex& m) {
+        return [&ring, &m](std::span<float> out) {
+            if constexpr (Locked) {
+                std::lock_guard guard(m);
+                return ring.read(out);
+            } else {
+                return ring.read(out);
+            }
+        };
+    };
+
+    std::thread worker([&] {
+        std::vector<float> block(hop);
+        auto read = reader(to_worker, lock_to_worker);
+        auto write = writer(to_main, lock_to_main);
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::span<float> rest(block);
+            while (!rest.empty() && !stop.load(std::memory_order_relaxed)) {
+                size_t n = read(rest);
+                rest = rest.subspan(n);
+                if (n == 0) std::this_thread::yield();
+            }
+            if (rest.empty()) write_all(block, write);
+        }
+    });
+
+    std::vector<float> block(hop, 1.0f), echo(hop);
+    auto write = writer(to_worker, lock_to_worker);
+    auto read = reader(to_main, lock_to_main);
+    for (auto _ : state) {
+        write_all(block, write);
+        read_all(echo, read);
+    }
+    stop = true;
+    worker.join();
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+}
+
+static void BM_SpscRingPingPong(benchmark::State& state) { ping_pong<false>(state); }
+BENCHMARK(BM_SpscRingPingPong)->Arg(160)->Arg(256)->Arg(512)->UseRealTime();
+
+static void BM_MutexRingPingPong(benchmark::State& state) { ping_pong<true>(state); }
+BENCHMARK(BM_MutexRingPingPong)->Arg(160)->Arg(256)->Arg(512)->UseRealTime();
+
+// Single-threaded cost of one hop in and out: the per-callback overhead with no contention
+static void BM_SpscRingWriteRead(benchmark::State& state) {
+    size_t hop = static_cast<size_t>(state.range(0));
+    signalflow::SpscRing<float> ring(4 * hop);
+    std::vector<float> block(hop, 1.0f), out(hop);
+    for (auto _ : state) {
+        ring.write(block);
+        ring.read(out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * hop * sizeof(float));
+}
+BENCHMARK(BM_SpscRingWriteRead)->Arg(160)->Arg(256)->Arg(512);
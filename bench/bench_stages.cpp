@@ -0,0 +1,173 @@
+#include <benchmark/benchmark.h>
+#include <signalflow/buffer.hpp>
+#include <signalflow/window.hpp>
+#include <signalflow/mel_scale.hpp>
+#include <signalflow/log_mel.hpp>
+#include <signalflow/codec.hpp>
+#include <cmath>
+#include <vector>
+
+// Per-stage microbenchmarks for the streaming frame loop. Each reports bytes or
+// items per second so runs at different sizes can be compared directly.
+
+static std::vector<float> test_signal(size_t n) {
+    std::vector<float> x(n);
+    for (size_t i = 0; i < n; ++i) x[i] = std::sin(0.01f * i) + 0.25f * std::sin(0.37f * i);
+    return x;
+}
+
+// One hop of samples pushed one at a time
+static void BM_CircularBufferPushSample(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    signalflow::CircularBuffer<float> buffer(N);
+    auto hop = test_signal(N / 2);
+    for (auto _ : state) {
+        for (float v : hop) buffer.push(v);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * hop.size() * sizeof(float));
+}
+BENCHMARK(BM_CircularBufferPushSample)->RangeMultiplier(2)->Range(256, 4096);
+
+// The same hop pushed as one span
+static void BM_CircularBufferPushSpan(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    signalflow::CircularBuffer<float> buffer(N);
+    auto hop = test_signal(N / 2);
+    for (auto _ : state) {
+        buffer.push(std::span<const float>(hop));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * hop.size() * sizeof(float));
+}
+BENCHMARK(BM_CircularBufferPushSpan)->RangeMultiplier(2)->Range(256, 4096);
+
+// Windowing a full ring buffer, whose oldest sample sits mid-array
+static void BM_WindowApplyBuffer(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    signalflow::CircularBuffer<float> buffer(N);
+    auto x = test_signal(N + N / 3);
+    buffer.push(std::span<const float>(x));
+    signalflow::Window window(N);
+    std::vector<float> out(N);
+    for (auto _ : state) {
+        window.apply(buffer, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * N * sizeof(float));
+}
+BENCHMARK(BM_WindowApplyBuffer)->RangeMultiplier(2)->Range(256, 4096);
+
+// Filterbank over one magnitude frame; args are n_fft and n_mels
+static void BM_MelFilterBankApply(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    size_t n_mels = static_cast<size_t>(state.range(1));
+    signalflow::MelFilterBank mel(N, 16000, n_mels);
+    auto magnitudes = test_signal(N / 2 + 1);
+    std::vector<float> out(n_mels);
+    for (auto _ : state) {
+        mel.apply(magnitudes, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MelFilterBankApply)->ArgsProduct({{256, 512, 1024, 2048, 4096}, {40, 64, 80, 128}});
+
+// Filterbank over a block of 256 frames; items are frames
+static void BM_MelFilterBankApplyBatch(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    size_t n_mels = static_cast<size_t>(state.range(1));
+    constexpr size_t kFrames = 256;
+    size_t n_bins = N / 2 + 1;
+    signalflow::MelFilterBank mel(N, 16000, n_mels);
+    auto magnitudes = test_signal(kFrames * n_bins);
+    std::vector<float> out(kFrames * n_mels);
+    for (auto _ : state) {
+        mel.apply_batch(magnitudes, n_bins, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kFrames);
+}
+BENCHMARK(BM_MelFilterBankApplyBatch)->ArgsProduct({{512, 1024, 2048}, {40, 64, 80, 128}});
+
+// Filterbank startup: building a plan from scratch, loading it from a blob, and the cached
+// lookup every MelFilterBank after the first gets; args are n_fft and n_mels
+static void BM_MelFilterPlanBuild(benchmark::State& state) {
+    signalflow::MelPlanKey key{static_cast<size_t>(state.range(0)), 16000, static_cast<size_t>(state.range(1)), 0.0f, 8000.0f};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(signalflow::make_mel_filter_plan(key));
+    }
+}
+BENCHMARK(BM_MelFilterPlanBuild)->ArgsProduct({{512, 2048}, {40, 128}});
+
+static void BM_MelFilterPlanLoad(benchmark::State& state) {
+    signalflow::MelPlanKey key{static_cast<size_t>(state.range(0)), 16000, static_cast<size_t>(state.range(1)), 0.0f, 8000.0f};
+    auto blob = signalflow::make_mel_filter_plan(key)->serialize();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(signalflow::MelFilterPlan::deserialize(blob));
+    }
+    state.SetBytesProcessed(state.iterations() * blob.size());
+}
+BENCHMARK(BM_MelFilterPlanLoad)->ArgsProduct({{512, 2048}, {40, 128}});
+
+static void BM_MelFilterBankCached(benchmark::State& state) {
+    size_t N = static_cast<size_t>(state.range(0));
+    size_t n_mels = static_cast<size_t>(state.range(1));
+    for (auto _ : state) {
+        signalflow::MelFilterBank mel(N, 16000, n_mels);
+        benchmark::DoNotOptimize(mel.plan().get());
+    }
+}
+BENCHMARK(BM_MelFilterBankCached)->ArgsProduct({{512, 2048}, {40, 128}});
+
+// Log-mel post-stage with normalization, against the std::log loop it replaces
+static void BM_LogMelStage(benchmark::State& state) {
+    size_t n_mels = static_cast<size_t>(state.range(0));
+    signalflow::LogMelOptions options;
+    options.normalize = true;
+    signalflow::LogMelStage stage(n_mels, options);
+    auto mel = test_signal(n_mels);
+    std::vector<float> frame(n_mels);
+    for (auto _ : state) {
+        std::copy(mel.begin(), mel.end(), frame.begin());
+        stage.apply(frame);
+        benchmark::DoNotOptimize(frame.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_mels);
+}
+BENCHMARK(BM_LogMelStage)->Arg(40)->Arg(64)->Arg(80)->Arg(128);
+
+static void BM_StdLog(benchmark::State& state) {
+    size_t n_mels = static_cast<size_t>(state.range(0));
+    auto mel = test_signal(n_mels);
+    std::vector<float> frame(n_mels);
+    for (auto _ : state) {
+        for (size_t m = 0; m < n_mels; ++m) frame[m] = std::log(std::max(std::abs(mel[m]), 1e-10f));
+        benchmark::DoNotOptimize(frame.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n_mels);
+}
+BENCHMARK(BM_StdLog)->Arg(40)->Arg(64)->Arg(80)->Arg(128);
+
+// Encoding a 100-frame batch of 80 log-mel values; the counter reports the compression
+static void BM_MelCodecEncode(benchmark::State& state) {
+    auto encoding = static_cast<signalflow::MelEncoding>(state.range(0));
+    const size_t n_mels = 80, frames = 100;
+    auto frames_in = test_signal(n_mels * frames);
+    for (auto& v : frames_in) v = std::log(1e-3f + v * v);
+    signalflow::MelCodec codec(n_mels, encoding);
+    std::vector<uint8_t> out;
+    out.reserve(codec.max_encoded_size(frames));
+    size_t bytes = 0;
+    for (auto _ : state) {
+        out.clear();
+        bytes = codec.encode(frames_in, out).bytes;
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * frames_in.size() * sizeof(float));
+    state.counters["ratio"] = static_cast<double>(frames_in.size() * sizeof(float)) / bytes;
+}
+BENCHMARK(BM_MelCodecEncode)->DenseRange(0, 2)->ArgNames({"encoding"});
@@ -0,0 +1,86 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+namespace signalflow {
+
+// Alignment of every allocation the library makes; arenas handed to it should start on
+// this boundary for ArenaSizer's figures to be exact
+inline constexpr size_t kArenaAlignment = 64;
+
+// Allocator returning storage aligned to Align bytes (a cache line by default),
+// so SIMD kernels start on a vector boundary and rows never straddle lines needlessly.
+// Storage comes from the global heap, or from a std::pmr::memory_resource (an arena,
+// a pool) when one is given; like std::pmr::polymorphic_allocator, containers keep
+// their resource when copied and it is not propagated on assignment. Move assignment
+// between containers on different resources therefore allocates and may throw.
+template <typename T, size_t Align = kArenaAlignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() noexcept = default;
+    // nullptr means the global heap
+    AlignedAllocator(std::pmr::memory_resource* resource) noexcept : resource_(resource) {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>& other) noexcept : resource_(other.resource()) {}
+
+    T* allocate(size_t n) {
+        if (resource_) return static_cast<T*>(resource_->allocate(n * sizeof(T), Align));
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* p, size_t n) noexcept {
+        if (resource_) return resource_->deallocate(p, n * sizeof(T), Align);
+        ::operator delete(p, std::align_val_t(Align));
+    }
+
+    std::pmr::memory_resource* resource() const noexcept { return resource_; }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>& other) const noexcept {
+        return resource_ == other.resource() || (resource_ && other.resource() && resource_->is_equal(*other.resource()));
+    }
+
+private:
+    std::pmr::memory_resource* resource_ = nullptr;
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+// Measures how large a fixed arena must be: allocations are served from the heap, but
+// counted the way std::pmr::monotonic_buffer_resource consumes a buffer (aligned bump
+// allocation, nothing returned on deallocate). Construct a pipeline with a sizer as its
+// resource, read bytes(), and an arena of that size starting on a kArenaAlignment
+// boundary holds the same pipeline exactly:
+//
+//     ArenaSizer sizer;
+//     { MelSpectrogram probe(512, 160, 16000, 40, ..., &sizer); }
+//     alignas(kArenaAlignment) static std::byte block[...];  // >= sizer.bytes()
+//     std::pmr::monotonic_buffer_resource arena(block, sizeof(block), std::pmr::null_memory_resource());
+class ArenaSizer final : public std::pmr::memory_resource {
+public:
+    size_t bytes() const { return bytes_; }
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        // monotonic_buffer_resource never hands out zero-byte blocks
+        bytes_ = (bytes_ + alignment - 1) / alignment * alignment + std::max<size_t>(bytes, 1);
+        return ::operator new(bytes, std::align_val_t(std::max(alignment, alignof(std::max_align_t))));
+    }
+    void do_deallocate(void* p, size_t, size_t alignment) override {
+        ::operator delete(p, std::align_val_t(std::max(alignment, alignof(std::max_align_t))));
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    size_t bytes_ = 0;
+};
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
+#include <signalflow/window.hpp>
+#include <signalflow/fft.hpp>
+#include <signalflow/mel_scale.hpp>
+#include <signalflow/thread_pool.hpp>
+#include <signalflow/instrument.hpp>
+
+namespace signalflow {
+
+// Row-major frames x n_mels matrix in one contiguous buffer
+struct MelMatrix {
+    size_t frames = 0;
+    size_t n_mels = 0;
+    std::vector<float> data;
+
+    std::span<float> row(size_t frame) { return {data.data() + frame * n_mels, n_mels}; }
+    std::span<const float> row(size_t frame) const { return {data.data() + frame * n_mels, n_mels}; }
+};
+
+// Offline mel spectrogram for whole signals. Frames are spread across a worker pool;
+// each worker has its own FFT scratch (the FFT plan itself is shared through the plan
+// cache) while the Window and MelFilterBank are read-only and shared. Frame k covers samples
+// [k * hop, k * hop + n_fft), exactly the frames MelSpectrogram would emit, and the
+// per-frame arithmetic is the same, so results are bit-identical to the streaming path.
+class BatchMelSpectrogram {
+public:
+    // threads == 0 uses one worker per hardware thread
+    BatchMelSpectrogram(size_t n_fft, size_t hop_size, int sample_rate, size_t n_mels = 40,
+                        float f_min = 0.0f, float f_max = 8000.0f,
+                        Window::Type window_type = Window::Type::Hann, size_t threads = 0,
+                        FFTBackend fft_backend = FFTBackend::Kiss)
+        : n_fft_(n_fft), hop_size_(hop_size),
+          window_(n_fft, window_type), mel_bank_(n_fft, sample_rate, n_mels, f_min, f_max),
+          pool_(threads) {
+        if (hop_size_ == 0 || hop_size_ > n_fft_) {
+            throw std::invalid_argument("BatchMelSpectrogram: hop_size must be in [1, n_fft]");
+        }
+        workers_.reserve(pool_.size());
+        for (size_t i = 0; i < pool_.size(); ++i) {
+            workers_.emplace_back(n_fft_, fft_backend);
+        }
+    }
+
+    // Number of complete frames in a signal of the given length
+    size_t frame_count(size_t samples) const {
+        return samples < n_fft_ ? 0 : (samples - n_fft_) / hop_size_ + 1;
+    }
+
+    MelMatrix process(std::span<const float> signal) {
+        std::vector<MelMatrix> out = process(std::span<const std::span<const float>>(&signal, 1));
+        return std::move(out.front());
+    }
+
+    // Processes N channels in one pass; frames from all channels share the pool
+    std::vector<MelMatrix> process(std::span<const std::span<const float>> channels) {
+        std::vector<MelMatrix> out(channels.size());
+        std::vector<size_t> first_frame(channels.size() + 1, 0); // Prefix sums over channels
+        for (size_t c = 0; c < channels.size(); ++c) {
+            out[c].frames = frame_count(channels[c].size());
+            out[c].n_mels = mel_bank_.n_mels();
+            out[c].data.resize(out[c].frames * out[c].n_mels);
+            first_frame[c + 1] = first_frame[c] + out[c].frames;
+        }
+
+        // Each chunk computes the magnitude rows of its frames, then projects them onto
+        // the mel filters with one apply_batch per run of frames from the same channel
+        const size_t n_bins = n_fft_ / 2 + 1;
+        pool_.parallel_for(first_frame.back(), kGrain, [&](size_t begin, size_t end, size_t worker) {
+            Worker& state = workers_[worker];
+            size_t c = std::upper_bound(first_frame.begin(), first_frame.end(), begin) - first_frame.begin() - 1;
+            size_t task = begin;
+            while (task < end) {
+                while (task >= first_frame[c + 1]) ++c;
+                size_t first = task - first_frame[c];
+                size_t count = std::min(end, first_frame[c + 1]) - task;
+                for (size_t k = 0; k < count; ++k) {
+                    {
+                        SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Window);
+                        window_.apply(channels[c].subspan((first + k) * hop_size_, n_fft_), state.windowed);
+                    }
+                    {
+                        SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::FFT);
+                        state.fft.compute_magnitude(state.windowed, std::span<float>(state.magnitudes).subspan(k * n_bins, n_bins));
+                    }
+                    SIGNALFLOW_INSTRUMENT_FRAME();
+                }
+                {
+                    SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::FilterBank);
+                    mel_bank_.apply_batch(std::span<const float>(state.magnitudes).first(count * n_bins), n_bins,
+                                          std::span<float>(out[c].data).subspan(first * out[c].n_mels, count * out[c].n_mels));
+                }
+                task += count;
+            }
+        });
+        return out;
+    }
+
+    size_t n_fft() const { return n_fft_; }
+    size_t hop_size() const { return hop_size_; }
+    size_t n_mels() const { return mel_bank_.n_mels(); }
+    size_t threads() const { return pool_.size(); }
+
+private:
+    // Frames per claimed chunk: large enough to amortise scheduling, small enough to balance
+    static constexpr size_t kGrain = 32;
+
+    struct Worker {
+        Worker(size_t n_fft, FFTBackend backend)
+            : fft(n_fft, backend), windowed(n_fft), magnitudes(kGrain * (n_fft / 2 + 1)) {}
+        FFT fft;
+        std::vector<float> windowed;
+        std::vector<float> magnitudes; // [kGrain x n_bins] block for apply_batch
+    };
+
+    size_t n_fft_;
+    size_t hop_size_;
+    Window window_;
+    MelFilterBank mel_bank_;
+    ThreadPool pool_;
+    std::vector<Worker> workers_;
+};
+
+}
@@ -1,37 +1,63 @@
 #pragma once
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <memory_resource>
+#include <signalflow/aligned.hpp>
 
 namespace signalflow {
 
     // Define a concept for numeric types (integral and floating point)
     template <typename T>
     concept Numeric = std::floating_point<T> || std::integral<T>;
-    
+
     // Define the class
     template <Numeric T> // Restricts the buffer to numbers
     class CircularBuffer {
-    public: 
-        explicit CircularBuffer(size_t capacity) {
+    public:
+        // Storage comes from resource when given (e.g. an arena), else the global heap
+        explicit CircularBuffer(size_t capacity, std::pmr::memory_resource* resource = nullptr)
+            : data_(AlignedAllocator<T>(resource)) {
             capacity_ = capacity;
             head_ = 0;
             is_full_ = false;
 
-            data_ = new T[capacity_];
-        }
-        ~CircularBuffer() {
-            delete[] data_;
+            // Value-initialise so slots that were never written read as zero
+            data_.assign(capacity_, T{});
         }
 
         // Push: Add a value and move the head
         void push(T value) {
             data_[head_] = value;
 
-            // Increment head and wrap around if necessary
-            head_ = (head_ + 1) % capacity_;
+            // Increment head and wrap around if necessary (a compare, not a modulo)
+            if (++head_ == capacity_) {
+                head_ = 0;
+                // Wrapping around means we filled the buffer at least once
+                is_full_ = true;
+            }
+        }
 
-            // If head wraps around to 0, it means we filled the buffer at least once
-            if (head_ == 0) {
+        // Bulk push: appends values in at most two memcpy's (before and after the wrap point).
+        // If more than capacity values are given, only the newest capacity are kept.
+        void push(std::span<const T> values) {
+            if (values.size() >= capacity_) {
+                std::memcpy(data_.data(), values.data() + values.size() - capacity_, capacity_ * sizeof(T));
+                head_ = 0;
+                is_full_ = true;
+                return;
+            }
+            size_t first = std::min(values.size(), capacity_ - head_);
+            std::memcpy(data_.data() + head_, values.data(), first * sizeof(T));
+            std::memcpy(data_.data(), values.data() + first, (values.size() - first) * sizeof(T));
+
+            head_ += values.size();
+            if (head_ >= capacity_) {
+                head_ -= capacity_;
                 is_full_ = true;
             }
         }
@@ -47,12 +73,48 @@ namespace signalflow {
             return data_[pos];
         }
 
+        // Contents from oldest to newest as two contiguous spans: the part before the
+        // wrap point followed by the part after it. Until the buffer has filled once,
+        // only the written samples are returned and the second span is empty.
+        std::pair<std::span<const T>, std::span<const T>> segments() const {
+            if (!is_full_) {
+                return {std::span<const T>(data_.data(), head_), std::span<const T>()};
+            }
+            return {std::span<const T>(data_.data() + head_, capacity_ - head_), std::span<const T>(data_.data(), head_)};
+        }
+
+        size_t capacity() const { return capacity_; }
+        size_t size() const { return is_full_ ? capacity_ : head_; }
+        // True once capacity values have been pushed, i.e. a complete frame is available
+        bool is_full() const { return is_full_; }
+
         // Disable copying to prevent memory crashes
         CircularBuffer(const CircularBuffer&) = delete;
         CircularBuffer& operator=(const CircularBuffer&) = delete;
-    
+
+        // Moving transfers ownership of the storage and leaves the source empty
+        CircularBuffer(CircularBuffer&& other) noexcept
+            : data_(std::move(other.data_)),
+              head_(std::exchange(other.head_, 0)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              is_full_(std::exchange(other.is_full_, false)) {}
+
+        // Not noexcept: the allocator keeps its resource on assignment, so when the two
+        // buffers use different resources the elements are moved into newly allocated
+        // storage from this buffer's resource, which can throw (e.g. a full arena)
+        CircularBuffer& operator=(CircularBuffer&& other) {
+            if (this != &other) {
+                data_ = std::move(other.data_);
+                other.data_.clear();
+                head_ = std::exchange(other.head_, 0);
+                capacity_ = std::exchange(other.capacity_, 0);
+                is_full_ = std::exchange(other.is_full_, false);
+            }
+            return *this;
+        }
+
     private:
-        T* data_;
+        AlignedVector<T> data_;
         size_t head_ = 0;
         size_t capacity_;
         bool is_full_ = false;
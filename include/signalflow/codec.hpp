@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <signalflow/simd.hpp>
+
+namespace signalflow {
+
+// Wire encodings for mel frames, from least to most compact on typical log-mel data
+enum class MelEncoding {
+    Float16,    // IEEE half per value: 2 bytes, relative error <= 2^-11
+    Int8,       // Per-frame affine int8: 8-byte (min, scale) header + 1 byte per value
+    DeltaVarint // Fixed-step integer codes, delta against the previous frame, zigzag + LEB128
+};
+
+// Result of one encode() call
+struct MelEncodeStats {
+    size_t bytes = 0;      // Bytes appended to the output
+    float max_error = 0.f; // Bound on |decoded - input| over every value in the batch
+};
+
+// Encoder/decoder for batches of mel frames (row-major [frames x n_mels] floats) sent
+// to remote inference. Every batch is self-contained: DeltaVarint codes its first frame
+// against zero, so a lost batch never corrupts the next one. Conversion and
+// quantisation are vectorised (F16C / AVX2 where available, identical results on the
+// scalar path); only the variable-length byte packing is scalar.
+//
+// Error bounds, also reported per batch by encode():
+//   Float16      half of a float16 ulp of each value (2^-11 relative for |x| >= 2^-14)
+//   Int8         (max - min) / 510 of each frame, plus float rounding
+//   DeltaVarint  step / 2, plus float rounding; codes are clamped to +-2^30 steps
+// Non-finite inputs are only representable in Float16.
+class MelCodec {
+public:
+    // step is the quantisation step for DeltaVarint (ignored otherwise), e.g. 0.01 for
+    // natural-log features. Throws std::invalid_argument for n_mels == 0 or step <= 0.
+    MelCodec(size_t n_mels, MelEncoding encoding, float step = 0.01f);
+
+    // Appends the encoding of frames (a whole number of rows) to out
+    MelEncodeStats encode(std::span<const float> frames, std::vector<uint8_t>& out) const;
+
+    // Decodes out.size() / n_mels() frames from the start of in; returns the bytes consumed.
+    // Throws std::invalid_argument if in is truncated or malformed.
+    size_t decode(std::span<const uint8_t> in, std::span<float> out) const;
+
+    // Exact encoded size for fixed-size encodings; an upper bound for DeltaVarint
+    size_t max_encoded_size(size_t frames) const;
+
+    size_t n_mels() const { return n_mels_; }
+    MelEncoding encoding() const { return encoding_; }
+    float step() const { return step_; }
+
+private:
+    size_t n_mels_;
+    MelEncoding encoding_;
+    float step_;
+};
+
+namespace codec {
+
+// IEEE binary16 conversion with round-to-nearest-even, overflow to infinity and quiet
+// NaNs, matching the F16C instructions. Vectorised where the CPU supports it.
+void float_to_half(const float* in, uint16_t* out, size_t n);
+void half_to_float(const uint16_t* in, float* out, size_t n);
+
+// Smallest and largest of n values, skipping NaNs (+inf / -inf if there are none); a
+// zero result is always +0. Used for Int8 frame ranges. Every level gives identical
+// results; the level is explicit so tests can compare the paths, as in simd.hpp.
+void min_max(const float* in, size_t n, float& lo, float& hi, simd::Level level = simd::active());
+
+}
+
+}
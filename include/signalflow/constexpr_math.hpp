@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <numbers>
+
+namespace signalflow::detail {
+
+// constexpr replacements for the <cmath> calls used to build window and mel tables.
+// Window and MelFilterBank use these only in constant evaluation (StaticMelPipeline's
+// tables), and <cmath> at run time, where these series would be slower. Results are
+// accurate to within an ulp or two of double precision, and are only ever narrowed to
+// float.
+
+constexpr double abs(double x) {
+    return x < 0.0 ? -x : x;
+}
+
+// Floor for values that fit in an int (FFT bin positions)
+constexpr int floor_to_int(float x) {
+    int truncated = static_cast<int>(x);
+    return (x < static_cast<float>(truncated)) ? truncated - 1 : truncated;
+}
+
+constexpr double cos(double x) {
+    // Reduce to [0, pi] using symmetry, then to [0, pi/2] with cos(pi - x) = -cos(x)
+    constexpr double two_pi = 2.0 * std::numbers::pi;
+    x = abs(x);
+    x -= two_pi * static_cast<double>(static_cast<long long>(x / two_pi));
+    if (x > std::numbers::pi) x = two_pi - x;
+    double sign = 1.0;
+    if (x > std::numbers::pi / 2.0) {
+        x = std::numbers::pi - x;
+        sign = -1.0;
+    }
+    // Taylor series; on [0, pi/2] the terms fall below 1e-17 well before 20 iterations
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; ++n) {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sign * sum;
+}
+
+// Natural log for x > 0
+constexpr double log(double x) {
+    // Scale into [1, 2) by exact powers of two, then ln(m) = 2 atanh((m - 1) / (m + 1))
+    int exponent = 0;
+    while (x >= 2.0) { x *= 0.5; ++exponent; }
+    while (x < 1.0) { x *= 2.0; --exponent; }
+    double z = (x - 1.0) / (x + 1.0);
+    double z2 = z * z;
+    double power = z;
+    double sum = 0.0;
+    for (int n = 0; n < 30; ++n) {
+        sum += power / (2 * n + 1);
+        power *= z2;
+    }
+    return 2.0 * sum + exponent * std::numbers::ln2;
+}
+
+constexpr double exp(double x) {
+    // x = k ln2 + r with |r| <= ln2 / 2, so exp(x) = 2^k exp(r)
+    long long k = static_cast<long long>(x / std::numbers::ln2 + (x < 0.0 ? -0.5 : 0.5));
+    double r = x - k * std::numbers::ln2;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 25; ++n) {
+        term *= r / n;
+        sum += term;
+    }
+    for (; k > 0; --k) sum *= 2.0;
+    for (; k < 0; ++k) sum *= 0.5;
+    return sum;
+}
+
+constexpr double log10(double x) {
+    return log(x) / std::numbers::ln10;
+}
+
+constexpr double pow10(double x) {
+    return exp(x * std::numbers::ln10);
+}
+
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string>
+#include <signalflow/aligned.hpp>
+
+namespace signalflow {
+
+// Element type of a stored feature matrix
+enum class FeatureType : uint32_t {
+    Float32 = 0,
+    Float16 = 1 // IEEE binary16, as produced by codec::float_to_half
+};
+
+// Fixed 64-byte header of a feature file, stored little-endian field by field on any host.
+// The row-major little-endian [frames x n_mels] matrix follows immediately, so it starts
+// 64-byte aligned in a mapping of the file and can be used in place, e.g. from numpy:
+//   np.memmap(path, dtype=np.float32, mode="r", offset=64, shape=(frames, n_mels))
+struct FeatureFileHeader {
+    static constexpr uint32_t kVersion = 1;
+    static constexpr uint32_t kLogMel = 1; // flags: values are log-mel features
+
+    char magic[8] = {'S', 'F', 'M', 'E', 'L', '\0', '\0', '\0'};
+    uint32_t version = kVersion;
+    FeatureType type = FeatureType::Float32;
+    uint64_t frames = 0;
+    uint32_t n_mels = 0;
+    uint32_t sample_rate = 0;
+    uint32_t n_fft = 0;
+    uint32_t hop_size = 0;
+    float f_min = 0.0f;
+    float f_max = 0.0f;
+    uint32_t flags = 0;
+    uint8_t reserved[12] = {};
+
+    size_t element_size() const { return type == FeatureType::Float16 ? 2 : 4; }
+    size_t data_bytes() const { return static_cast<size_t>(frames) * n_mels * element_size(); }
+};
+
+static_assert(sizeof(FeatureFileHeader) == 64, "feature file header must stay 64 bytes");
+
+// Writes header and matrix to path. The data goes to a uniquely named temporary file next
+// to path, is fsynced and then renamed into place, so readers never see a partial file,
+// concurrent writers of one path do not collide, and a crash cannot leave a truncated
+// file behind under path. Throws
+// std::invalid_argument if the data does not match header.frames x header.n_mels of
+// header.type, and std::runtime_error on I/O failure.
+void write_feature_file(const std::string& path, const FeatureFileHeader& header, std::span<const float> data);
+void write_feature_file(const std::string& path, const FeatureFileHeader& header, std::span<const uint16_t> data);
+
+// Writes a feature file a block of rows at a time, so a matrix of any length is stored in
+// constant memory. Rows go to a temporary file as they arrive; commit() fills in the frame
+// count and moves the file into place just as write_feature_file does. A writer destroyed
+// without commit() removes its temporary and leaves path untouched.
+class FeatureFileWriter {
+public:
+    // header.frames is ignored. Throws std::invalid_argument if header.n_mels is 0 and
+    // std::runtime_error if the temporary file cannot be created.
+    FeatureFileWriter(const std::string& path, const FeatureFileHeader& header);
+    ~FeatureFileWriter();
+
+    FeatureFileWriter(const FeatureFileWriter&) = delete;
+    FeatureFileWriter& operator=(const FeatureFileWriter&) = delete;
+
+    // Appends whole rows of n_mels values. Float16 files also take floats, converted with
+    // codec::float_to_half. Throws std::invalid_argument for a partial row or halves given
+    // to a Float32 file, and std::runtime_error on I/O failure.
+    void append(std::span<const float> rows);
+    void append(std::span<const uint16_t> rows);
+
+    uint64_t frames() const { return header_.frames; }
+
+    // Throws std::runtime_error if the file cannot be completed; the temporary is removed
+    void commit();
+
+private:
+    void check_rows(size_t count) const;
+    void fail();
+
+    std::string path_;
+    std::string temp_;
+    std::FILE* file_ = nullptr;
+    FeatureFileHeader header_;
+};
+
+// Read-only memory mapping of a feature file; the matrix is viewed in place (big-endian
+// hosts read a byte-swapped copy instead)
+class FeatureFile {
+public:
+    // Throws std::runtime_error if the file cannot be mapped, is not a feature file, or
+    // its size does not match the header
+    explicit FeatureFile(const std::string& path);
+    ~FeatureFile();
+
+    FeatureFile(const FeatureFile&) = delete;
+    FeatureFile& operator=(const FeatureFile&) = delete;
+
+    const FeatureFileHeader& header() const { return header_; }
+    size_t frames() const { return static_cast<size_t>(header_.frames); }
+    size_t n_mels() const { return header_.n_mels; }
+    FeatureType type() const { return header_.type; }
+
+    // The whole matrix; throws std::logic_error if the file holds the other type
+    std::span<const float> floats() const;
+    std::span<const uint16_t> halves() const;
+
+    // One row as float, whatever the stored type
+    void row(size_t frame, std::span<float> out) const;
+
+private:
+    const unsigned char* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const unsigned char* data_ = nullptr; // The matrix, in the host's byte order
+    AlignedVector<unsigned char> swapped_;
+    FeatureFileHeader header_;
+};
+
+}
@@ -1,45 +1,81 @@
 #pragma once
 #include <vector>
+#include <span>
+#include <stdexcept>
+#include <memory>
 #include <cmath>
 #include <complex>
+#include <memory_resource>
+#include <signalflow/aligned.hpp>
 #include <signalflow/buffer.hpp>
-
-extern "C" {
-    #include "kiss_fftr.h"
-}
+#include <signalflow/simd.hpp>
+#include <signalflow/fft_plan.hpp>
 
 namespace signalflow {
 
 class FFT {
 public:
-    // Allocates FFT configuration for a given FFT size
-    explicit FFT(size_t nfft) : nfft_(nfft) {
-        cfg_ = kiss_fftr_alloc(static_cast<int>(nfft_), 0, nullptr, nullptr);
-    }
-
-    // Frees the FFT configuration
-    ~FFT() {
-        if (cfg_) free(cfg_);
-    }
+    // Looks up the shared plan for this size and backend; only the scratch is per object.
+    // Kiss is the reference backend; Radix4 (or Auto) is faster for power-of-two sizes.
+    // With a resource, this FFT builds its own plan there instead, so it and its scratch
+    // never touch the global heap.
+    explicit FFT(size_t nfft, FFTBackend backend = FFTBackend::Kiss, std::pmr::memory_resource* resource = nullptr)
+        : nfft_(nfft), plan_(resource ? make_fft_plan(nfft, backend, resource) : fft_plan(nfft, backend)),
+          spectrum_(2 * plan_->num_bins(), 0.0f, AlignedAllocator<float>(resource)),
+          scratch_(plan_->scratch_size(), 0.0f, AlignedAllocator<float>(resource)) {}
 
     // Computes the magnitude spectrum of the input windowed data
     template <Numeric T>
     std::vector<float> compute_magnitude(const std::vector<T>& windowed_data) {
+        std::vector<float> magnitudes(num_bins());
+        compute_magnitude(windowed_data, magnitudes);
+        return magnitudes;
+    }
+
+    // Same as above, but writes num_bins() magnitudes into a caller-owned buffer.
+    // The complex spectrum goes through scratch held by this object, so no allocation happens here.
+    void compute_magnitude(std::span<const float> windowed_data, std::span<float> magnitudes) {
         size_t num_bins = nfft_ / 2 + 1;
-        std::vector<kiss_fft_cpx> out_cpx(num_bins);
-        std::vector<float> magnitudes(num_bins);
+        if (windowed_data.size() < nfft_ || magnitudes.size() < num_bins) {
+            throw std::invalid_argument("FFT: input or output span too small");
+        }
 
-        kiss_fftr(cfg_, windowed_data.data(), out_cpx.data());
+        plan_->forward(windowed_data.data(), spectrum_.data(), scratch_.data());
+
+        simd::magnitude(spectrum_.data(), magnitudes.data(), num_bins);
+    }
 
-        for (size_t i = 0; i < num_bins; ++i) {
-            magnitudes[i] = std::sqrt(out_cpx[i].r * out_cpx[i].r + out_cpx[i].i * out_cpx[i].i);
+    // Computes the power spectrum (squared magnitude) into a caller-owned buffer
+    void compute_power(std::span<const float> windowed_data, std::span<float> power) {
+        size_t num_bins = nfft_ / 2 + 1;
+        if (windowed_data.size() < nfft_ || power.size() < num_bins) {
+            throw std::invalid_argument("FFT: input or output span too small");
         }
-        return magnitudes;
+
+        plan_->forward(windowed_data.data(), spectrum_.data(), scratch_.data());
+
+        simd::power(spectrum_.data(), power.data(), num_bins);
+    }
+
+    // Writes the num_bins() complex bins of the one-sided spectrum
+    void compute_complex(std::span<const float> windowed_data, std::span<std::complex<float>> spectrum) {
+        if (windowed_data.size() < nfft_ || spectrum.size() < num_bins()) {
+            throw std::invalid_argument("FFT: input or output span too small");
+        }
+
+        // std::complex<float> is layout-compatible with float[2]
+        plan_->forward(windowed_data.data(), reinterpret_cast<float*>(spectrum.data()), scratch_.data());
     }
 
+    size_t size() const { return nfft_; }
+    size_t num_bins() const { return nfft_ / 2 + 1; }
+    FFTBackend backend() const { return plan_->backend(); }
+
 private:
     size_t nfft_;
-    kiss_fftr_cfg cfg_;
+    std::shared_ptr<const FFTPlan> plan_;
+    AlignedVector<float> spectrum_; // Interleaved (re, im) bins
+    AlignedVector<float> scratch_;
 };
 
-}
\ No newline at end of file
+}
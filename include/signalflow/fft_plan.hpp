@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+namespace signalflow {
+
+enum class FFTBackend {
+    Kiss,   // Reference: kiss_fft, any even size
+    Radix4, // Built-in power-of-two real FFT with SIMD radix-2^2 butterflies
+    Auto    // Radix4 for powers of two, Kiss otherwise
+};
+
+// Immutable forward real-FFT plan: twiddles, permutation tables and backend choice.
+// A plan holds no mutable state (callers pass their own scratch), so one plan can be
+// shared by any number of FFT objects on any number of threads.
+class FFTPlan {
+public:
+    virtual ~FFTPlan() = default;
+
+    size_t size() const { return nfft_; }
+    size_t num_bins() const { return nfft_ / 2 + 1; }
+    virtual FFTBackend backend() const = 0;
+
+    // Number of floats of scratch forward() needs
+    virtual size_t scratch_size() const = 0;
+
+    // Transforms size() real samples into num_bins() interleaved (re, im) pairs, laid out
+    // like kiss_fft_cpx / std::complex<float>
+    virtual void forward(const float* in, float* out, float* scratch) const = 0;
+
+protected:
+    explicit FFTPlan(size_t nfft) : nfft_(nfft) {}
+
+private:
+    size_t nfft_;
+};
+
+// Builds a new, uncached plan. Throws std::invalid_argument if the backend cannot handle
+// nfft (odd sizes, or a non-power-of-two size for Radix4).
+std::unique_ptr<FFTPlan> make_fft_plan(size_t nfft, FFTBackend backend);
+
+// Same, but the plan object and all of its tables (the kiss_fft config is placed with
+// kiss_fft_alloc's mem/lenmem) are allocated from resource, e.g. an arena. The resource
+// must outlive the plan.
+std::shared_ptr<const FFTPlan> make_fft_plan(size_t nfft, FFTBackend backend, std::pmr::memory_resource* resource);
+
+// Returns the process-wide shared plan for (nfft, backend), building it on first use.
+// Thread-safe; plans live until exit, so constructing many FFTs of one size is cheap.
+std::shared_ptr<const FFTPlan> fft_plan(size_t nfft, FFTBackend backend);
+
+}
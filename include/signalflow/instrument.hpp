@@ -0,0 +1,168 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Per-stage hot-path timing. Build with SIGNALFLOW_INSTRUMENT=1 (the CMake option of the
+// same name) to record; otherwise the SIGNALFLOW_INSTRUMENT_* macros expand to nothing and
+// the pipeline code is exactly as without them. snapshot() works either way.
+// MelSpectrogram, BatchMelSpectrogram and StreamEngine all record; the batched paths run
+// the filterbank once per block of frames, so their FilterBank entries are per block.
+#ifndef SIGNALFLOW_INSTRUMENT
+#define SIGNALFLOW_INSTRUMENT 0
+#endif
+
+namespace signalflow::instrument {
+
+enum class Stage {
+    Ingest,      // Pushing samples into the frame buffer (StreamEngine::push into a ring)
+    Window,      // Window::apply
+    FFT,         // FFT::compute_magnitude / compute_power
+    FilterBank,  // MelFilterBank::apply, or one apply_batch block
+    PostProcess, // Log-mel stage
+    Callback,    // The caller's on_frame
+    Count
+};
+
+inline constexpr size_t kStageCount = static_cast<size_t>(Stage::Count);
+
+const char* name(Stage stage);
+
+struct StageStats {
+    uint64_t count = 0;
+    double p50_ns = 0.0;
+    double p99_ns = 0.0;
+    double max_ns = 0.0;
+    double mean_ns = 0.0;
+};
+
+struct Snapshot {
+    std::array<StageStats, kStageCount> stages{};
+    uint64_t frames = 0;
+
+    const StageStats& operator[](Stage stage) const { return stages[static_cast<size_t>(stage)]; }
+};
+
+// Merges every thread's histograms (including threads that have exited). Percentiles
+// are bucket upper bounds, so within 1/16 of the true value. Safe to call while
+// recording continues; counts recorded concurrently may or may not be included.
+Snapshot snapshot();
+
+// Zeroes all histograms; intended for between runs, not concurrently with recording
+void reset();
+
+constexpr bool enabled() { return SIGNALFLOW_INSTRUMENT != 0; }
+
+namespace detail {
+
+// HDR-style log-linear buckets over raw timer ticks: exact below 16, then 16 buckets per
+// power of two, so every bucket spans at most 1/16 of its values. Ticks up to 2^40 are
+// resolved; larger ones land in the last bucket.
+inline constexpr unsigned kSubBits = 4;
+inline constexpr unsigned kMaxBits = 40;
+inline constexpr size_t kBuckets = ((kMaxBits - kSubBits + 1) << kSubBits);
+
+constexpr size_t bucket_index(uint64_t ticks) {
+    if (ticks < (1u << kSubBits)) return static_cast<size_t>(ticks);
+    unsigned exponent = static_cast<unsigned>(std::bit_width(ticks)) - 1;
+    if (exponent >= kMaxBits) return kBuckets - 1;
+    size_t sub = static_cast<size_t>(ticks >> (exponent - kSubBits)) & ((1u << kSubBits) - 1);
+    return (static_cast<size_t>(exponent - kSubBits + 1) << kSubBits) + sub;
+}
+
+// Largest tick count that maps to the bucket
+constexpr uint64_t bucket_upper(size_t index) {
+    if (index < (1u << kSubBits)) return index;
+    unsigned exponent = static_cast<unsigned>(index >> kSubBits) + kSubBits - 1;
+    uint64_t sub = index & ((1u << kSubBits) - 1);
+    uint64_t width = uint64_t(1) << (exponent - kSubBits);
+    return (((uint64_t(1) << kSubBits) + sub) << (exponent - kSubBits)) + width - 1;
+}
+
+// One thread's counters. Only the owning thread writes (plain load + store, no locked
+// read-modify-write); snapshot() reads them with relaxed loads from any thread.
+struct ThreadHistograms {
+    std::array<std::array<std::atomic<uint64_t>, kBuckets>, kStageCount> buckets{};
+    std::array<std::atomic<uint64_t>, kStageCount> total{};
+    std::array<std::atomic<uint64_t>, kStageCount> max{};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<bool> in_use{false};
+};
+
+// Registers a histogram block for the calling thread (reusing one from an exited thread
+// when possible) and releases it again
+ThreadHistograms& acquire();
+void release(ThreadHistograms& histograms);
+
+inline ThreadHistograms& local() {
+    struct Handle {
+        ThreadHistograms& histograms = acquire();
+        ~Handle() { release(histograms); }
+    };
+    thread_local Handle handle;
+    return handle.histograms;
+}
+
+inline void bump(std::atomic<uint64_t>& counter, uint64_t by) {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+// Timer ticks: the TSC on x86 (converted to ns at snapshot time), steady_clock ns elsewhere
+inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline void record(Stage stage, uint64_t ticks) {
+    ThreadHistograms& h = local();
+    size_t s = static_cast<size_t>(stage);
+    bump(h.buckets[s][bucket_index(ticks)], 1);
+    bump(h.total[s], ticks);
+    if (ticks > h.max[s].load(std::memory_order_relaxed)) h.max[s].store(ticks, std::memory_order_relaxed);
+}
+
+inline void count_frame() {
+    bump(local().frames, 1);
+}
+
+}
+
+// Times its enclosing scope into the stage's histogram
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stage stage) : stage_(stage), start_(detail::now()) {}
+    ~ScopedTimer() { detail::record(stage_, detail::now() - start_); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Stage stage_;
+    uint64_t start_;
+};
+
+}
+
+#define SIGNALFLOW_INSTRUMENT_CONCAT_(a, b) a##b
+#define SIGNALFLOW_INSTRUMENT_CONCAT(a, b) SIGNALFLOW_INSTRUMENT_CONCAT_(a, b)
+
+#if SIGNALFLOW_INSTRUMENT
+// Times the rest of the enclosing scope as the given instrument::Stage
+#define SIGNALFLOW_INSTRUMENT_SCOPE(stage) \
+    ::signalflow::instrument::ScopedTimer SIGNALFLOW_INSTRUMENT_CONCAT(signalflow_timer_, __LINE__)(stage)
+// Counts one emitted frame
+#define SIGNALFLOW_INSTRUMENT_FRAME() ::signalflow::instrument::detail::count_frame()
+#else
+#define SIGNALFLOW_INSTRUMENT_SCOPE(stage) static_cast<void>(0)
+#define SIGNALFLOW_INSTRUMENT_FRAME() static_cast<void>(0)
+#endif
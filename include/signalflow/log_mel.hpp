@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <memory_resource>
+#include <signalflow/aligned.hpp>
+#include <signalflow/simd.hpp>
+
+namespace signalflow {
+
+struct LogMelOptions {
+    // What the filterbank integrates: |X| or |X|^2. Log-mel models usually expect power.
+    enum class Spectrum { Magnitude, Power };
+    // Natural log, or decibels (10 log10 of power, 20 log10 of magnitude)
+    enum class Scale { Log, Decibel };
+
+    Spectrum spectrum = Spectrum::Power;
+    Scale scale = Scale::Log;
+    float floor = 1e-10f;   // Mel energies are clamped to at least this before the log
+    bool normalize = false; // Running per-mel mean/variance normalization
+    float decay = 0.99f;    // Weight of the previous statistics per frame, in [0, 1)
+    float epsilon = 1e-5f;  // Added to the variance before dividing by its square root
+};
+
+// Post-stage turning filterbank output into log-mel features, in place on the frame
+// the filterbank just wrote (so it is still in L1): clamp to the floor, fast vectorised
+// log (simd::log_floor) scaled to ln or dB, then optionally normalise each mel band by
+// its running mean and standard deviation.
+//
+// The statistics are exponentially decaying with bias correction: frame t is weighted
+// by 1 / W_t where W_t = decay * W_{t-1} + 1, so early frames get an exact running
+// mean and the weight settles to 1 - decay (a time constant of 1 / (1 - decay) frames).
+// The first frame after construction or reset() therefore normalises to zero.
+class LogMelStage {
+public:
+    explicit LogMelStage(size_t n_mels, const LogMelOptions& options = {},
+                         std::pmr::memory_resource* resource = nullptr)
+        : options_(options), mean_(n_mels, 0.0f, AlignedAllocator<float>(resource)),
+          variance_(n_mels, 0.0f, AlignedAllocator<float>(resource)) {
+        if (!(options_.floor >= std::numeric_limits<float>::min())) {
+            throw std::invalid_argument("LogMelStage: floor must be a positive normal float");
+        }
+        if (!(options_.decay >= 0.0f && options_.decay < 1.0f)) {
+            throw std::invalid_argument("LogMelStage: decay must be in [0, 1)");
+        }
+        scale_ = 1.0f;
+        if (options_.scale == LogMelOptions::Scale::Decibel) {
+            float per_decade = options_.spectrum == LogMelOptions::Spectrum::Power ? 10.0f : 20.0f;
+            scale_ = per_decade / std::numbers::ln10_v<float>;
+        }
+    }
+
+    // Transforms the first n_mels() values of mel in place
+    void apply(std::span<float> mel) {
+        const size_t n = mean_.size();
+        if (mel.size() < n) {
+            throw std::invalid_argument("LogMelStage: frame smaller than n_mels");
+        }
+        simd::log_floor(mel.data(), mel.data(), n, options_.floor, scale_);
+        if (!options_.normalize) return;
+
+        weight_ = options_.decay * weight_ + 1.0f;
+        const float k = 1.0f / weight_;
+        for (size_t m = 0; m < n; ++m) {
+            float delta = mel[m] - mean_[m];
+            mean_[m] += k * delta;
+            variance_[m] = (1.0f - k) * (variance_[m] + k * delta * delta);
+            mel[m] = (mel[m] - mean_[m]) / std::sqrt(variance_[m] + options_.epsilon);
+        }
+    }
+
+    // Forgets the running statistics, e.g. at a stream boundary
+    void reset() {
+        std::fill(mean_.begin(), mean_.end(), 0.0f);
+        std::fill(variance_.begin(), variance_.end(), 0.0f);
+        weight_ = 0.0f;
+    }
+
+    size_t n_mels() const { return mean_.size(); }
+    const LogMelOptions& options() const { return options_; }
+    std::span<const float> mean() const { return mean_; }
+    std::span<const float> variance() const { return variance_; }
+
+private:
+    LogMelOptions options_;
+    float scale_;
+    float weight_ = 0.0f;
+    AlignedVector<float> mean_;
+    AlignedVector<float> variance_;
+};
+
+}
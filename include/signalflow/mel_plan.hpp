@@ -0,0 +1,85 @@
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <signalflow/aligned.hpp>
+
+namespace signalflow {
+
+// Parameters identifying a mel filterbank. Plans are always keyed by the normalized form
+// (MelFilterBank::normalize), so equivalent parameter sets share one plan.
+struct MelPlanKey {
+    size_t n_fft = 0;
+    int sample_rate = 0;
+    size_t n_mels = 0;
+    float f_min = 0.0f;
+    float f_max = 0.0f;
+
+    auto operator<=>(const MelPlanKey&) const = default;
+};
+
+// Immutable triangular mel filterbank in compressed sparse row form: filter m covers bins
+// [start_bins()[m], start_bins()[m] + length) with its weights at
+// weights()[offsets()[m] .. offsets()[m+1]). Only the nonzero support of each filter is
+// stored, and every filter lies within the n_fft / 2 + 1 spectrum bins. Like FFTPlan, a
+// plan has no mutable state and is shared by any number of MelFilterBanks.
+class MelFilterPlan {
+public:
+    // Builds the filters for key (normalized first). This is the only place the mel-scale
+    // log/pow math runs. Throws std::invalid_argument for sample_rate <= 0.
+    explicit MelFilterPlan(const MelPlanKey& key, std::pmr::memory_resource* resource = nullptr);
+
+    // Adopts precomputed tables, e.g. from a generated header, without any math. Throws
+    // std::invalid_argument if key is not normalized or the tables are inconsistent with it.
+    MelFilterPlan(const MelPlanKey& key, std::span<const uint32_t> start_bins, std::span<const uint32_t> offsets,
+                  std::span<const float> weights, std::pmr::memory_resource* resource = nullptr);
+
+    const MelPlanKey& key() const { return key_; }
+    size_t n_mels() const { return key_.n_mels; }
+    size_t n_bins() const { return key_.n_fft / 2 + 1; }
+
+    std::span<const uint32_t> start_bins() const { return start_bins_; }
+    std::span<const uint32_t> offsets() const { return offsets_; }
+    std::span<const float> weights() const { return weights_; }
+
+    // Little-endian binary blob: magic, version, the key, the three arrays and a checksum
+    std::vector<uint8_t> serialize() const;
+
+    // Inverse of serialize(). Throws std::invalid_argument on a truncated, corrupt or
+    // inconsistent blob.
+    static std::shared_ptr<const MelFilterPlan> deserialize(std::span<const uint8_t> blob);
+
+    // C++ source of a header holding this plan as constexpr arrays in namespace name, with
+    // an inline register_plan() that seeds the process-wide cache from them
+    std::string header(std::string_view name) const;
+
+private:
+    void validate() const;
+
+    MelPlanKey key_;
+    AlignedVector<uint32_t> start_bins_;
+    AlignedVector<uint32_t> offsets_;
+    AlignedVector<float> weights_;
+};
+
+// Builds a new, uncached plan. With a resource, the plan object and its tables are
+// allocated from it; the resource must outlive the plan.
+std::shared_ptr<const MelFilterPlan> make_mel_filter_plan(const MelPlanKey& key,
+                                                          std::pmr::memory_resource* resource = nullptr);
+
+// Returns the process-wide shared plan for key, building it on first use unless one was
+// registered. Thread-safe; plans live until exit.
+std::shared_ptr<const MelFilterPlan> mel_filter_plan(const MelPlanKey& key);
+
+// Puts plan into the cache under its key, replacing any plan already there, so later
+// lookups (and every MelFilterBank with those parameters) use it instead of building one.
+// Banks constructed earlier keep the plan they have.
+void register_mel_filter_plan(std::shared_ptr<const MelFilterPlan> plan);
+
+}
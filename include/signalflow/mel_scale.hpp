@@ -1,94 +1,190 @@
 #pragma once
 #include <vector>
+#include <memory>
+#include <span>
+#include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+#include <memory_resource>
+#include <signalflow/aligned.hpp>
+#include <signalflow/mel_plan.hpp>
+#include <signalflow/simd.hpp>
+#include <signalflow/constexpr_math.hpp>
 
 namespace signalflow {
 
 class MelFilterBank {
 public:
+    // View of one triangular filter inside the packed weight array
     struct Filter {
         size_t start_bin;
-        std::vector<float> weights;
+        std::span<const float> weights;
     };
 
-    MelFilterBank(size_t n_fft, int sample_rate, size_t n_mels = 40, float f_min = 0.0f, float f_max = 8000.0f)
-        : n_fft_(n_fft), sample_rate_(sample_rate), n_mels_(n_mels) {
-        // Parameter validation
-        if (n_mels_ == 0) n_mels_ = 1; // Avoid zero mel bins
-        if (f_max <= f_min) {
-            // Swap or set to default range if invalid
-            f_min = 0.0f;
-            f_max = 8000.0f;
-        }
+    // Uses the process-wide plan for these parameters (see mel_plan.hpp), so banks of one
+    // configuration share their tables. With a resource, this bank builds its own plan
+    // there instead. Parameters are normalized first (see normalize()).
+    MelFilterBank(size_t n_fft, int sample_rate, size_t n_mels = 40, float f_min = 0.0f, float f_max = 8000.0f,
+                  std::pmr::memory_resource* resource = nullptr)
+        : MelFilterBank(resource ? make_mel_filter_plan({n_fft, sample_rate, n_mels, f_min, f_max}, resource)
+                                 : mel_filter_plan({n_fft, sample_rate, n_mels, f_min, f_max})) {}
 
-        // 1. Convert frequency boundaries to Mel scale
-        float mel_min = hz_to_mel(f_min);
-        float mel_max = hz_to_mel(f_max);
+    // Wraps an existing plan, e.g. one loaded with MelFilterPlan::deserialize(). Throws
+    // std::invalid_argument if plan is null.
+    explicit MelFilterBank(std::shared_ptr<const MelFilterPlan> plan)
+        : plan_(checked(std::move(plan))), n_mels_(plan_->n_mels()) {}
+
+    // This converts the FFT Magnitudes into Mel Bins
+    std::vector<float> apply(const std::vector<float>& fft_magnitudes) const {
+        std::vector<float> mel_spec(n_mels_);
+        apply(fft_magnitudes, mel_spec);
+        return mel_spec;
+    }
 
-        // 2. Create equally spaced points in Mel space
-        std::vector<float> mel_points(n_mels_ + 2);
-        for (size_t i = 0; i < n_mels_ + 2; ++i) {
-            mel_points[i] = mel_min + i * (mel_max - mel_min) / (n_mels_ + 1);
+    // Same as above, but writes n_mels() values into a caller-owned buffer
+    void apply(std::span<const float> fft_magnitudes, std::span<float> mel_spec) const {
+        if (mel_spec.size() < n_mels_) {
+            throw std::invalid_argument("MelFilterBank: output span too small");
+        }
+        // Each filter is one fused multiply-add dot product over contiguous weights.
+        // Filters running past the end of the input are clipped once, not per element.
+        const size_t n_bins = fft_magnitudes.size();
+        const uint32_t* start_bins = plan_->start_bins().data();
+        const uint32_t* offsets = plan_->offsets().data();
+        const float* weights = plan_->weights().data();
+        for (size_t m = 0; m < n_mels_; ++m) {
+            size_t start = start_bins[m];
+            size_t len = offsets[m+1] - offsets[m];
+            len = start < n_bins ? std::min(len, n_bins - start) : 0;
+            mel_spec[m] = simd::dot(fft_magnitudes.data() + start, weights + offsets[m], len);
         }
+    }
 
-        // 3. Convert Mel points back to FFT bin indices
-        std::vector<int> bins(n_mels_ + 2);
-        for (size_t i = 0; i < n_mels_ + 2; ++i) {
-            float hz = mel_to_hz(mel_points[i]);
-            bins[i] = static_cast<int>(std::floor((n_fft_ + 1) * hz / sample_rate_));
+    // Applies the filterbank to a block of frames at once: magnitudes is row-major
+    // [frames x n_bins] and mel_spec receives [frames x n_mels]. This is a banded sparse
+    // matrix product; frames are processed in cache-sized blocks, filter by filter, so
+    // each filter's weights stay hot across the whole block. Each output is bit-identical
+    // to apply() on the same row.
+    void apply_batch(std::span<const float> magnitudes, size_t n_bins, std::span<float> mel_spec) const {
+        if (n_bins == 0 || magnitudes.size() % n_bins != 0) {
+            throw std::invalid_argument("MelFilterBank: magnitude block is not a whole number of rows");
+        }
+        const size_t frames = magnitudes.size() / n_bins;
+        if (mel_spec.size() < frames * n_mels_) {
+            throw std::invalid_argument("MelFilterBank: output span too small");
         }
+        // Keep a block of magnitude rows within roughly half of a typical L2
+        const size_t block = std::clamp<size_t>(kBlockBytes / (n_bins * sizeof(float)), 4, 256);
+        const uint32_t* start_bins = plan_->start_bins().data();
+        const uint32_t* offsets = plan_->offsets().data();
+        const float* weights = plan_->weights().data();
 
-        // 4. Build the triangular filters
-        filters_.resize(n_mels_);
-        for (size_t m = 1; m <= n_mels_; ++m) {
-            filters_[m-1].start_bin = bins[m-1];
-            size_t filter_len = bins[m+1] - bins[m-1];
-            if (filter_len <= 0) filter_len = 1; // Avoid invalid vector size
-            filters_[m-1].weights.resize(filter_len);
-
-            for (int k = bins[m-1]; k < bins[m+1]; ++k) {
-                float weight = 0.0f;
-                if (k < bins[m]) {
-                    weight = static_cast<float>(k - bins[m-1]) / (bins[m] - bins[m-1] + 1e-6f);
-                } else {
-                    weight = static_cast<float>(bins[m+1] - k) / (bins[m+1] - bins[m] + 1e-6f);
-                }
-                if ((k - bins[m-1]) >= 0 && (size_t)(k - bins[m-1]) < filters_[m-1].weights.size())
-                    filters_[m-1].weights[k - bins[m-1]] = weight;
+        for (size_t first = 0; first < frames; first += block) {
+            size_t count = std::min(block, frames - first);
+            const float* rows = magnitudes.data() + first * n_bins;
+            float* out = mel_spec.data() + first * n_mels_;
+            for (size_t m = 0; m < n_mels_; ++m) {
+                size_t start = start_bins[m];
+                size_t len = offsets[m+1] - offsets[m];
+                len = start < n_bins ? std::min(len, n_bins - start) : 0;
+                simd::dot_rows(rows + start, n_bins, count, weights + offsets[m], len, out + m, n_mels_);
             }
         }
     }
 
-    // This converts the FFT Magnitudes into Mel Bins
-    std::vector<float> apply(const std::vector<float>& fft_magnitudes) const {
-        std::vector<float> mel_spec(n_mels_, 0.0f);
-        
-        for (size_t m = 0; m < n_mels_; ++m) {
-            const auto& filter = filters_[m];
-            for (size_t j = 0; j < filter.weights.size(); ++j) {
-                size_t bin_idx = filter.start_bin + j;
-                if (bin_idx < fft_magnitudes.size()) {
-                    mel_spec[m] += fft_magnitudes[bin_idx] * filter.weights[j];
-                }
-            }
+    size_t n_mels() const { return n_mels_; }
+
+    const std::shared_ptr<const MelFilterPlan>& plan() const { return plan_; }
+
+    Filter filter(size_t m) const {
+        auto offsets = plan_->offsets();
+        return {plan_->start_bins()[m], plan_->weights().subspan(offsets[m], offsets[m+1] - offsets[m])};
+    }
+
+    // The helpers below are constexpr so compile-time pipelines (StaticMelPipeline)
+    // build their tables the same way as this class. Constant evaluation uses the series
+    // in constexpr_math.hpp and run time uses <cmath>, so the two may differ in the last bit.
+
+    // Canonical parameters: at least one band, 0 <= f_min < f_max <= Nyquist (bands
+    // above Nyquist would have no bins). An empty or invalid range (NaN included) falls
+    // back to 0 .. min(8000, Nyquist).
+    static constexpr MelPlanKey normalize(MelPlanKey key) {
+        if (key.n_mels == 0) key.n_mels = 1; // Avoid zero mel bins
+        const float nyquist = key.sample_rate / 2.0f;
+        if (!(key.f_min >= 0.0f)) key.f_min = 0.0f;
+        if (key.f_max > nyquist) key.f_max = nyquist;
+        if (!(key.f_max > key.f_min)) {
+            key.f_min = 0.0f;
+            key.f_max = std::min(8000.0f, nyquist);
+        }
+        return key;
+    }
+
+    static constexpr float hz_to_mel(float hz) {
+        if consteval {
+            return 2595.0f * static_cast<float>(detail::log10(1.0f + hz / 700.0f));
+        } else {
+            return 2595.0f * std::log10(1.0f + hz / 700.0f);
+        }
+    }
+
+    static constexpr float mel_to_hz(float mel) {
+        if consteval {
+            return 700.0f * (static_cast<float>(detail::pow10(mel / 2595.0f)) - 1.0f);
+        } else {
+            return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
+        }
+    }
+
+    // Writes the n_mels + 2 filter boundary bins: points equally spaced in mel between
+    // f_min and f_max, converted back to FFT bin indices
+    static constexpr void boundary_bins(size_t n_fft, int sample_rate, size_t n_mels,
+                                        float f_min, float f_max, int* bins) {
+        // 1. Convert frequency boundaries to Mel scale
+        float mel_min = hz_to_mel(f_min);
+        float mel_max = hz_to_mel(f_max);
+
+        for (size_t i = 0; i < n_mels + 2; ++i) {
+            // 2. Create equally spaced points in Mel space
+            float mel_point = mel_min + i * (mel_max - mel_min) / (n_mels + 1);
+            // 3. Convert Mel points back to FFT bin indices
+            float hz = mel_to_hz(mel_point);
+            bins[i] = detail::floor_to_int((n_fft + 1) * hz / sample_rate);
         }
-        return mel_spec;
     }
 
-    static float hz_to_mel(float hz) {
-        return 2595.0f * std::log10(1.0f + hz / 700.0f);
+    // Nonzero support of the filter over boundary bins (lo, mid, hi), clipped to the
+    // n_bins spectrum bins: the weights are zero at lo and hi, so the support is
+    // (lo, hi) plus the peak at mid, which also covers filters collapsed to one bin.
+    // Returns the first bin and the length (0 only if the whole filter lies above n_bins).
+    static constexpr std::pair<size_t, size_t> filter_support(int lo, int mid, int hi, size_t n_bins) {
+        int first = std::max(lo < mid ? lo + 1 : mid, 0);
+        int last = std::min(mid < hi ? hi - 1 : mid, static_cast<int>(n_bins) - 1);
+        if (last < first) return {std::min(static_cast<size_t>(first), n_bins), 0};
+        return {static_cast<size_t>(first), static_cast<size_t>(last - first + 1)};
     }
 
-    static float mel_to_hz(float mel) {
-        return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
+    // Triangular weight of bin k inside filter_support(): rising over (lo, mid), exactly 1
+    // at mid, falling over (mid, hi)
+    static constexpr float filter_weight(int k, int lo, int mid, int hi) {
+        if (k == mid) return 1.0f;
+        if (k < mid) {
+            return static_cast<float>(k - lo) / static_cast<float>(mid - lo);
+        }
+        return static_cast<float>(hi - k) / static_cast<float>(hi - mid);
     }
 
 private:
-    size_t n_fft_;
-    int sample_rate_;
+    static constexpr size_t kBlockBytes = 128 * 1024;
+
+    static std::shared_ptr<const MelFilterPlan> checked(std::shared_ptr<const MelFilterPlan> plan) {
+        if (!plan) throw std::invalid_argument("MelFilterBank: null plan");
+        return plan;
+    }
+
+    std::shared_ptr<const MelFilterPlan> plan_;
     size_t n_mels_;
-    std::vector<Filter> filters_;
 };
 
 } 
\ No newline at end of file
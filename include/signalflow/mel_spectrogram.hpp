@@ -0,0 +1,154 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <span>
+#include <optional>
+#include <stdexcept>
+#include <memory_resource>
+#include <signalflow/aligned.hpp>
+#include <signalflow/buffer.hpp>
+#include <signalflow/spsc_ring.hpp>
+#include <signalflow/window.hpp>
+#include <signalflow/fft.hpp>
+#include <signalflow/mel_scale.hpp>
+#include <signalflow/log_mel.hpp>
+#include <signalflow/instrument.hpp>
+
+namespace signalflow {
+
+// Streaming mel spectrogram: owns the Window -> FFT -> MelFilterBank chain and
+// accepts PCM chunks of any size. Once the first n_fft samples have arrived it
+// emits one mel frame every hop_size samples. The ring buffer holds the overlap,
+// so nothing is rebuilt or copied between frames, and all intermediate
+// buffers are owned here so steady-state processing does not allocate.
+// Given a std::pmr::memory_resource, every table, a private FFT plan and all scratch are
+// allocated from it, so a pipeline can live in one fixed block (see required_bytes()).
+// Built with SIGNALFLOW_INSTRUMENT, each stage of the frame loop is timed (instrument.hpp).
+class MelSpectrogram {
+public:
+    MelSpectrogram(size_t n_fft, size_t hop_size, int sample_rate, size_t n_mels = 40,
+                   float f_min = 0.0f, float f_max = 8000.0f,
+                   Window::Type window_type = Window::Type::Hann,
+                   FFTBackend fft_backend = FFTBackend::Kiss,
+                   std::optional<LogMelOptions> log_mel = std::nullopt,
+                   std::pmr::memory_resource* resource = nullptr)
+        : n_fft_(n_fft), hop_size_(hop_size),
+          buffer_(n_fft, resource), window_(n_fft, window_type, resource), fft_(n_fft, fft_backend, resource),
+          mel_bank_(n_fft, sample_rate, n_mels, f_min, f_max, resource),
+          windowed_(n_fft, 0.0f, resource), magnitudes_(fft_.num_bins(), 0.0f, resource),
+          mel_(mel_bank_.n_mels(), 0.0f, resource), until_next_frame_(n_fft) {
+        if (hop_size_ == 0 || hop_size_ > n_fft_) {
+            throw std::invalid_argument("MelSpectrogram: hop_size must be in [1, n_fft]");
+        }
+        // With a log-mel stage the frames are log features, over power or magnitude
+        if (log_mel) {
+            log_mel_.emplace(mel_bank_.n_mels(), *log_mel, resource);
+            power_ = log_mel->spectrum == LogMelOptions::Spectrum::Power;
+        }
+    }
+
+    // Feeds a chunk of samples. on_frame(std::span<const float>) is called with each
+    // completed mel frame; the span is only valid for the duration of the call.
+    // Returns the number of frames emitted.
+    template <typename Callback>
+    size_t process(std::span<const float> samples, Callback&& on_frame) {
+        size_t frames = 0;
+        while (!samples.empty()) {
+            // Bulk-push up to the next frame boundary
+            size_t count = std::min(samples.size(), until_next_frame_);
+            {
+                SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Ingest);
+                buffer_.push(samples.first(count));
+            }
+            samples = samples.subspan(count);
+            until_next_frame_ -= count;
+
+            if (until_next_frame_ == 0) {
+                {
+                    SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Window);
+                    window_.apply(buffer_, windowed_);
+                }
+                {
+                    SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::FFT);
+                    if (power_) {
+                        fft_.compute_power(windowed_, magnitudes_);
+                    } else {
+                        fft_.compute_magnitude(windowed_, magnitudes_);
+                    }
+                }
+                {
+                    SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::FilterBank);
+                    mel_bank_.apply(magnitudes_, mel_);
+                }
+                if (log_mel_) {
+                    SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::PostProcess);
+                    log_mel_->apply(mel_);
+                }
+                {
+                    SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Callback);
+                    on_frame(std::span<const float>(mel_));
+                }
+                SIGNALFLOW_INSTRUMENT_FRAME();
+                until_next_frame_ = hop_size_;
+                ++frames;
+            }
+        }
+        return frames;
+    }
+
+    // Consumer side of an SpscRing: processes everything the producer has published so
+    // far, straight out of the ring's storage in hop-sized steps, then releases it. Call
+    // from the ring's single consumer thread.
+    template <typename Callback>
+    size_t process(SpscRing<float>& ring, Callback&& on_frame) {
+        auto [first, second] = ring.readable();
+        size_t frames = process(first, on_frame);
+        frames += process(second, on_frame);
+        ring.consume(first.size() + second.size());
+        return frames;
+    }
+
+    // Drops any partially accumulated frame; the next frame needs n_fft fresh samples.
+    // Log-mel normalization statistics start over too.
+    void reset() {
+        until_next_frame_ = n_fft_;
+        if (log_mel_) log_mel_->reset();
+    }
+
+    size_t n_fft() const { return n_fft_; }
+    size_t hop_size() const { return hop_size_; }
+    size_t n_mels() const { return mel_bank_.n_mels(); }
+
+    // Bytes of arena (starting on a kArenaAlignment boundary) that a pipeline with these
+    // arguments needs when constructed with a std::pmr::monotonic_buffer_resource over it:
+    // every table, its private FFT plan and all scratch. Processing allocates nothing.
+    static size_t required_bytes(size_t n_fft, size_t hop_size, int sample_rate, size_t n_mels = 40,
+                                 float f_min = 0.0f, float f_max = 8000.0f,
+                                 Window::Type window_type = Window::Type::Hann,
+                                 FFTBackend fft_backend = FFTBackend::Kiss,
+                                 std::optional<LogMelOptions> log_mel = std::nullopt) {
+        ArenaSizer sizer;
+        {
+            MelSpectrogram probe(n_fft, hop_size, sample_rate, n_mels, f_min, f_max, window_type,
+                                 fft_backend, log_mel, &sizer);
+        }
+        return sizer.bytes();
+    }
+
+private:
+    size_t n_fft_;
+    size_t hop_size_;
+    CircularBuffer<float> buffer_;
+    Window window_;
+    FFT fft_;
+    MelFilterBank mel_bank_;
+    // Per-frame scratch, sized once so steady-state processing never allocates
+    AlignedVector<float> windowed_;
+    AlignedVector<float> magnitudes_; // Or power, with a power log-mel stage
+    AlignedVector<float> mel_;
+    std::optional<LogMelStage> log_mel_;
+    bool power_ = false;
+    size_t until_next_frame_;
+};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace signalflow::simd {
+
+// Instruction sets the hot-path kernels are built for. Which ones are compiled in
+// depends on the target architecture; supported() says whether this CPU can run one.
+enum class Level { Scalar, NEON, AVX2, AVX512 };
+
+// Best level this CPU supports, probed once at first use
+Level active();
+
+bool supported(Level level);
+const char* name(Level level);
+
+// The kernels below take an explicit level so tests can compare every path;
+// normal callers just use the default. A level this CPU does not support (or that
+// is not compiled in) runs as active() instead.
+
+// Writes sqrt(re^2 + im^2) for n interleaved (re, im) pairs
+void magnitude(const float* interleaved, float* out, size_t n, Level level = active());
+
+// Writes re^2 + im^2 for n interleaved (re, im) pairs
+void power(const float* interleaved, float* out, size_t n, Level level = active());
+
+// Returns sum(a[i] * b[i]) over n elements
+float dot(const float* a, const float* b, size_t n, Level level = active());
+
+// Dot products of count rows against one weight vector: row r starts at
+// rows + r * row_stride and its result goes to out[r * out_stride]. Weights are
+// loaded once per group of rows, and each result is bit-identical to dot().
+void dot_rows(const float* rows, size_t row_stride, size_t count,
+              const float* weights, size_t n, float* out, size_t out_stride, Level level = active());
+
+// Converts frames of interleaved 16-bit PCM to mono float: each sample is scaled by
+// 1/32768 (as dr_wav does) and the channels are averaged. Mono and stereo have
+// vector paths; other channel counts use the scalar loop.
+void pcm16_to_mono(const int16_t* in, size_t channels, float* out, size_t frames, Level level = active());
+
+// Writes scale * ln(min(max(in[i], floor), FLT_MAX)); NaN inputs give the floor.
+// floor must be a positive normal float. A branch-free polynomial log: error at most
+// 4.6e-8 absolute where |ln x| <= 1 and 0.71 ulp elsewhere. The AVX2 path matches the
+// scalar path exactly. in and out may alias.
+void log_floor(const float* in, float* out, size_t n, float floor, float scale, Level level = active());
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <signalflow/aligned.hpp>
+#include <signalflow/buffer.hpp>
+
+namespace signalflow {
+
+// Wait-free single-producer / single-consumer ring for handing samples from an audio
+// capture callback to a DSP thread. One thread may call write() and free_space(); one
+// other thread may call read(), readable(), consume() and available(). Neither side
+// ever blocks or loops on the other, so a slow consumer shows up as a short write
+// (an overrun the producer can count) instead of priority inversion.
+//
+// head_ and tail_ are free-running counters (only ever incremented), masked into the
+// power-of-two storage, so full and empty are distinguishable without a spare slot.
+// Each side also caches the other's counter on its own cache line and only re-reads
+// the shared atomic when the cached value says there is not enough room or data.
+template <Numeric T>
+class SpscRing {
+public:
+    // capacity is rounded up to a power of two; storage comes from resource when given
+    explicit SpscRing(size_t capacity, std::pmr::memory_resource* resource = nullptr)
+        : data_(AlignedAllocator<T>(resource)) {
+        if (capacity == 0) {
+            throw std::invalid_argument("SpscRing: capacity must be positive");
+        }
+        capacity_ = std::bit_ceil(capacity);
+        mask_ = capacity_ - 1;
+        data_.assign(capacity_, T{});
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // --- Producer side -----------------------------------------------------------
+
+    // Appends as many values as fit (at most two memcpy's) and returns how many were written
+    size_t write(std::span<const T> values) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (capacity_ - (head - producer_tail_) < values.size()) {
+            producer_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        size_t count = std::min(values.size(), capacity_ - (head - producer_tail_));
+
+        size_t pos = head & mask_;
+        size_t first = std::min(count, capacity_ - pos);
+        std::memcpy(data_.data() + pos, values.data(), first * sizeof(T));
+        std::memcpy(data_.data(), values.data() + first, (count - first) * sizeof(T));
+
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t free_space() const {
+        return capacity_ - (head_.load(std::memory_order_relaxed) - tail_.load(std::memory_order_acquire));
+    }
+
+    // --- Consumer side -----------------------------------------------------------
+
+    // Copies up to out.size() values out and returns how many were read
+    size_t read(std::span<T> out) {
+        auto [first, second] = readable(out.size());
+        std::memcpy(out.data(), first.data(), first.size() * sizeof(T));
+        std::memcpy(out.data() + first.size(), second.data(), second.size() * sizeof(T));
+        consume(first.size() + second.size());
+        return first.size() + second.size();
+    }
+
+    // Zero-copy read: up to max_count of the oldest values as two contiguous spans (before
+    // and after the wrap point). They stay valid, and the producer cannot overwrite them,
+    // until consume() releases them.
+    std::pair<std::span<const T>, std::span<const T>> readable(size_t max_count = SIZE_MAX) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (consumer_head_ - tail < max_count) {
+            consumer_head_ = head_.load(std::memory_order_acquire);
+        }
+        size_t count = std::min(max_count, consumer_head_ - tail);
+
+        size_t pos = tail & mask_;
+        size_t first = std::min(count, capacity_ - pos);
+        return {std::span<const T>(data_.data() + pos, first), std::span<const T>(data_.data(), count - first)};
+    }
+
+    // Releases the oldest count values back to the producer; count must not exceed
+    // what readable() last returned
+    void consume(size_t count) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    size_t available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    static constexpr size_t kCacheLine = 64;
+
+    // Shared counters, each on its own line so producer and consumer do not false-share
+    alignas(kCacheLine) std::atomic<size_t> head_{0};
+    alignas(kCacheLine) std::atomic<size_t> tail_{0};
+    // Producer-private snapshot of tail_
+    alignas(kCacheLine) size_t producer_tail_ = 0;
+    // Consumer-private snapshot of head_
+    alignas(kCacheLine) size_t consumer_head_ = 0;
+    // Read-only after construction
+    alignas(kCacheLine) size_t capacity_ = 0;
+    size_t mask_ = 0;
+    AlignedVector<T> data_;
+};
+
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <signalflow/window.hpp>
+#include <signalflow/mel_scale.hpp>
+#include <signalflow/simd.hpp>
+
+extern "C" {
+    #include "kiss_fftr.h"
+}
+
+namespace signalflow {
+
+// Fixed-configuration streaming mel spectrogram for targets that always run one setup
+// (e.g. 1024 / 512 / 40 at 16 kHz). The window coefficients and the packed mel
+// filterbank are generated at compile time into static std::array tables, using the
+// same constexpr helpers as Window and MelFilterBank, so the numerics match the runtime
+// classes. All state lives inside the object, including the kiss_fftr configuration,
+// which is placed in an in-object buffer, so nothing ever touches the heap.
+template <size_t NFFT, size_t Hop, size_t NMels, int SampleRate,
+          float FMin = 0.0f, float FMax = 8000.0f, Window::Type WindowType = Window::Type::Hann>
+class StaticMelPipeline {
+    static_assert(NFFT >= 2 && NFFT % 2 == 0, "kiss_fftr needs an even FFT size");
+    static_assert(Hop >= 1 && Hop <= NFFT, "hop must be in [1, NFFT]");
+    static_assert(NMels >= 1, "need at least one mel band");
+    static_assert(FMin < FMax, "FMin must be below FMax");
+
+public:
+    static constexpr size_t kBins = NFFT / 2 + 1;
+
+    StaticMelPipeline() {
+        size_t len = fft_state_.size();
+        cfg_ = kiss_fftr_alloc(static_cast<int>(NFFT), 0, fft_state_.data(), &len);
+        if (!cfg_) {
+            throw std::logic_error("StaticMelPipeline: kiss_fftr state does not fit its buffer");
+        }
+    }
+
+    // cfg_ points into this object, so it can be neither copied nor moved
+    StaticMelPipeline(const StaticMelPipeline&) = delete;
+    StaticMelPipeline& operator=(const StaticMelPipeline&) = delete;
+
+    // Same contract as MelSpectrogram::process: on_frame(std::span<const float>) is called
+    // for each completed frame. Returns the number of frames emitted.
+    template <typename Callback>
+    size_t process(std::span<const float> samples, Callback&& on_frame) {
+        size_t frames = 0;
+        while (!samples.empty()) {
+            size_t count = std::min(samples.size(), until_next_frame_);
+            push(samples.first(count));
+            samples = samples.subspan(count);
+            until_next_frame_ -= count;
+
+            if (until_next_frame_ == 0) {
+                compute_frame();
+                on_frame(std::span<const float>(mel_));
+                until_next_frame_ = Hop;
+                ++frames;
+            }
+        }
+        return frames;
+    }
+
+    // Drops any partially accumulated frame; the next frame needs NFFT fresh samples
+    void reset() {
+        until_next_frame_ = NFFT;
+    }
+
+    static constexpr const std::array<float, NFFT>& window_coefficients() { return kWindow; }
+
+    static constexpr MelFilterBank::Filter filter(size_t m) {
+        return {kSupports[m].first,
+                std::span<const float>(kWeights.data() + kOffsets[m], kOffsets[m + 1] - kOffsets[m])};
+    }
+
+private:
+    // --- Compile-time tables -------------------------------------------------------
+
+    static constexpr std::array<float, NFFT> kWindow = [] {
+        std::array<float, NFFT> w{};
+        for (size_t i = 0; i < NFFT; ++i) w[i] = Window::coefficient(i, NFFT, WindowType);
+        return w;
+    }();
+
+    // Same normalization as MelFilterBank (f_max clamped to Nyquist, ...)
+    static constexpr MelPlanKey kKey = MelFilterBank::normalize({NFFT, SampleRate, NMels, FMin, FMax});
+
+    static constexpr std::array<int, NMels + 2> kBoundaries = [] {
+        std::array<int, NMels + 2> bins{};
+        MelFilterBank::boundary_bins(NFFT, SampleRate, NMels, kKey.f_min, kKey.f_max, bins.data());
+        return bins;
+    }();
+
+    // Filter supports, already clipped to the spectrum, as in MelFilterPlan
+    static constexpr std::array<std::pair<size_t, size_t>, NMels> kSupports = [] {
+        std::array<std::pair<size_t, size_t>, NMels> supports{};
+        for (size_t m = 0; m < NMels; ++m) {
+            supports[m] = MelFilterBank::filter_support(kBoundaries[m], kBoundaries[m + 1], kBoundaries[m + 2], kBins);
+        }
+        return supports;
+    }();
+
+    // Packed layout identical to MelFilterPlan: weights of filter m at [kOffsets[m], kOffsets[m+1])
+    static constexpr std::array<size_t, NMels + 1> kOffsets = [] {
+        std::array<size_t, NMels + 1> offsets{};
+        for (size_t m = 0; m < NMels; ++m) offsets[m + 1] = offsets[m] + kSupports[m].second;
+        return offsets;
+    }();
+
+    static constexpr std::array<float, kOffsets[NMels]> kWeights = [] {
+        std::array<float, kOffsets[NMels]> weights{};
+        for (size_t m = 0; m < NMels; ++m) {
+            auto [first, length] = kSupports[m];
+            for (size_t j = 0; j < length; ++j) {
+                weights[kOffsets[m] + j] = MelFilterBank::filter_weight(static_cast<int>(first + j), kBoundaries[m],
+                                                                        kBoundaries[m + 1], kBoundaries[m + 2]);
+            }
+        }
+        return weights;
+    }();
+
+    // Upper bound on kiss_fftr_alloc's memneeded: the kiss_fftr_state header, the
+    // kiss_fft_state (factors plus NFFT/2 twiddles), and 3/2 * NFFT/2 complex values of
+    // scratch and super-twiddles, with slack for alignment padding
+    static constexpr size_t kFftStateBytes =
+        4 * sizeof(void*) + (2 + 2 * 32) * sizeof(int) +
+        sizeof(kiss_fft_cpx) * (NFFT / 2 + (NFFT / 2) * 3 / 2) + 64;
+
+    // --- Per-frame work ------------------------------------------------------------
+
+    // Each sample is written twice, NFFT apart, so the newest NFFT samples are always
+    // contiguous at ring_[pos_, pos_ + NFFT) and windowing is one fixed-length loop
+    void push(std::span<const float> samples) {
+        while (!samples.empty()) {
+            size_t count = std::min(samples.size(), NFFT - pos_);
+            std::memcpy(ring_.data() + pos_, samples.data(), count * sizeof(float));
+            std::memcpy(ring_.data() + pos_ + NFFT, samples.data(), count * sizeof(float));
+            pos_ = (pos_ + count) % NFFT;
+            samples = samples.subspan(count);
+        }
+    }
+
+    void compute_frame() {
+        const float* frame = ring_.data() + pos_;
+        for (size_t i = 0; i < NFFT; ++i) {
+            windowed_[i] = frame[i] * kWindow[i];
+        }
+        kiss_fftr(cfg_, windowed_.data(), spectrum_.data());
+        simd::magnitude(reinterpret_cast<const float*>(spectrum_.data()), magnitudes_.data(), kBins);
+        for (size_t m = 0; m < NMels; ++m) {
+            mel_[m] = simd::dot(magnitudes_.data() + kSupports[m].first, kWeights.data() + kOffsets[m], kSupports[m].second);
+        }
+    }
+
+    alignas(64) std::array<float, 2 * NFFT> ring_{};
+    alignas(64) std::array<float, NFFT> windowed_{};
+    alignas(64) std::array<kiss_fft_cpx, kBins> spectrum_{};
+    alignas(64) std::array<float, kBins> magnitudes_{};
+    std::array<float, NMels> mel_{};
+    alignas(16) std::array<unsigned char, kFftStateBytes> fft_state_{};
+    kiss_fftr_cfg cfg_ = nullptr;
+    size_t pos_ = 0;
+    size_t until_next_frame_ = NFFT;
+};
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+#include <vector>
+#include <span>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <signalflow/spsc_ring.hpp>
+#include <signalflow/window.hpp>
+#include <signalflow/fft.hpp>
+#include <signalflow/mel_scale.hpp>
+#include <signalflow/log_mel.hpp>
+#include <signalflow/thread_pool.hpp>
+#include <signalflow/instrument.hpp>
+
+namespace signalflow {
+
+// Mel spectrograms for many concurrent streams (one per connected sensor) on one
+// shared chain. The Window, FFT plan and MelFilterBank exist once per engine and are
+// read-only; a stream only owns its sample ring (which also holds the n_fft - hop
+// overlap) and, with a log-mel stage, its normalization statistics. Per-stream memory
+// is therefore stream_state_bytes(), independent of how many streams there are.
+//
+// Each stream's ring is single-producer: one thread per stream may push() while
+// process() runs. process() hands out streams to a work-stealing pool; each worker
+// windows and transforms the ready frames of its streams into a block, projects the
+// whole block onto the mel filters with one apply_batch, then runs the log-mel stage
+// and the callback frame by frame. Frames are exactly those MelSpectrogram would emit
+// for the same samples, with bit-identical values.
+class StreamEngine {
+public:
+    using StreamId = size_t;
+
+    // threads == 0 uses one worker per hardware thread. stream_capacity is the ring size
+    // in samples (rounded up to a power of two); 0 picks 2 * n_fft. It must hold at
+    // least n_fft, and bounds how far a producer can run ahead of process().
+    StreamEngine(size_t n_fft, size_t hop_size, int sample_rate, size_t n_mels = 40,
+                 float f_min = 0.0f, float f_max = 8000.0f,
+                 Window::Type window_type = Window::Type::Hann, size_t threads = 0,
+                 FFTBackend fft_backend = FFTBackend::Kiss,
+                 std::optional<LogMelOptions> log_mel = std::nullopt, size_t stream_capacity = 0)
+        : n_fft_(n_fft), hop_size_(hop_size),
+          stream_capacity_(stream_capacity == 0 ? 2 * n_fft : stream_capacity),
+          window_(n_fft, window_type), mel_bank_(n_fft, sample_rate, n_mels, f_min, f_max),
+          log_mel_(log_mel), pool_(threads) {
+        if (hop_size_ == 0 || hop_size_ > n_fft_) {
+            throw std::invalid_argument("StreamEngine: hop_size must be in [1, n_fft]");
+        }
+        if (stream_capacity_ < n_fft_) {
+            throw std::invalid_argument("StreamEngine: stream_capacity must be at least n_fft");
+        }
+        power_ = log_mel_ && log_mel_->spectrum == LogMelOptions::Spectrum::Power;
+        workers_.reserve(pool_.size());
+        for (size_t i = 0; i < pool_.size(); ++i) {
+            workers_.emplace_back(n_fft_, mel_bank_.n_mels(), fft_backend);
+        }
+    }
+
+    // --- Control plane: not concurrent with process() or with pushes to the stream ---
+
+    // Returns the new stream's id; ids of removed streams are reused
+    StreamId add_stream() {
+        auto stream = std::make_unique<Stream>(stream_capacity_);
+        if (log_mel_) stream->log_mel.emplace(mel_bank_.n_mels(), *log_mel_);
+        if (!free_ids_.empty()) {
+            StreamId id = free_ids_.back();
+            free_ids_.pop_back();
+            streams_[id] = std::move(stream);
+            return id;
+        }
+        streams_.push_back(std::move(stream));
+        return streams_.size() - 1;
+    }
+
+    // Drops the stream and any samples still queued for it
+    void remove_stream(StreamId id) {
+        checked(id);
+        streams_[id].reset();
+        free_ids_.push_back(id);
+    }
+
+    // --- Data plane ----------------------------------------------------------------
+
+    // Queues samples for a stream and returns how many fit; a short count is an overrun.
+    // Safe to call while process() runs, from at most one thread per stream.
+    size_t push(StreamId id, std::span<const float> samples) {
+        SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Ingest);
+        return checked(id).ring.write(samples);
+    }
+
+    // Emits every complete frame queued on any stream, calling on_frame(StreamId,
+    // std::span<const float> mel) from the worker threads. Frames of one stream arrive
+    // in order on one thread at a time; different streams run concurrently. The span is
+    // only valid for the duration of the call. Returns the number of frames emitted.
+    template <typename Callback>
+    size_t process(Callback&& on_frame) {
+        for (auto& worker : workers_) {
+            worker.rows = 0;
+            worker.frames = 0;
+        }
+        pool_.parallel_for_stealing(streams_.size(), kStreamGrain, [&](size_t begin, size_t end, size_t worker) {
+            Worker& state = workers_[worker];
+            for (size_t id = begin; id < end; ++id) {
+                if (!streams_[id]) continue;
+                Stream& stream = *streams_[id];
+                size_t available = stream.ring.available();
+                size_t frames = available < n_fft_ ? 0 : (available - n_fft_) / hop_size_ + 1;
+                for (size_t k = 0; k < frames; ++k) {
+                    if (state.rows == kBlockFrames) flush(state, on_frame);
+                    // The frame is the oldest n_fft samples; releasing one hop keeps the overlap
+                    {
+                        SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Window);
+                        auto [older, newer] = stream.ring.readable(n_fft_);
+                        window_.apply(older, newer, state.windowed);
+                        stream.ring.consume(hop_size_);
+                    }
+                    auto row = std::span<float>(state.spectra).subspan(state.rows * state.n_bins, state.n_bins);
+                    {
+                        SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::FFT);
+                        if (power_) {
+                            state.fft.compute_power(state.windowed, row);
+                        } else {
+                            state.fft.compute_magnitude(state.windowed, row);
+                        }
+                    }
+                    state.owners[state.rows++] = id;
+                }
+            }
+            flush(state, on_frame);
+        });
+        size_t total = 0;
+        for (const auto& worker : workers_) total += worker.frames;
+        return total;
+    }
+
+    // Samples queued on a stream and not yet released by process()
+    size_t queued(StreamId id) const { return checked(id).ring.available(); }
+
+    // Heap and object bytes owned by one stream; the shared plans are not counted
+    size_t stream_state_bytes() const {
+        size_t bytes = sizeof(Stream) + std::bit_ceil(stream_capacity_) * sizeof(float);
+        if (log_mel_) bytes += 2 * mel_bank_.n_mels() * sizeof(float);
+        return bytes;
+    }
+
+    size_t stream_count() const { return streams_.size() - free_ids_.size(); }
+    size_t n_fft() const { return n_fft_; }
+    size_t hop_size() const { return hop_size_; }
+    size_t n_mels() const { return mel_bank_.n_mels(); }
+    size_t threads() const { return pool_.size(); }
+
+private:
+    // Streams per claimed chunk, and frames per worker block for apply_batch
+    static constexpr size_t kStreamGrain = 16;
+    static constexpr size_t kBlockFrames = 32;
+
+    struct Stream {
+        explicit Stream(size_t capacity) : ring(capacity) {}
+        SpscRing<float> ring;
+        std::optional<LogMelStage> log_mel;
+    };
+
+    // Cache-line aligned so workers never share a line
+    struct alignas(64) Worker {
+        Worker(size_t n_fft, size_t n_mels, FFTBackend backend)
+            : fft(n_fft, backend), n_bins(fft.num_bins()), windowed(n_fft),
+              spectra(kBlockFrames * n_bins), mel(kBlockFrames * n_mels), owners(kBlockFrames) {}
+        FFT fft;
+        size_t n_bins;
+        std::vector<float> windowed;
+        std::vector<float> spectra;  // [kBlockFrames x n_bins] rows awaiting the filterbank
+        std::vector<float> mel;      // [kBlockFrames x n_mels]
+        std::vector<StreamId> owners; // Stream of each pending row
+        size_t rows = 0;
+        size_t frames = 0;
+    };
+
+    // Filterbank for the worker's pending rows, then the per-stream log-mel stage and
+    // callback in row order (which is frame order within each stream)
+    template <typename Callback>
+    void flush(Worker& state, Callback& on_frame) {
+        if (state.rows == 0) return;
+        const size_t n_mels = mel_bank_.n_mels();
+        {
+            SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::FilterBank);
+            mel_bank_.apply_batch(std::span<const float>(state.spectra).first(state.rows * state.n_bins), state.n_bins,
+                                  state.mel);
+        }
+        for (size_t r = 0; r < state.rows; ++r) {
+            auto mel = std::span<float>(state.mel).subspan(r * n_mels, n_mels);
+            Stream& stream = *streams_[state.owners[r]];
+            if (stream.log_mel) {
+                SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::PostProcess);
+                stream.log_mel->apply(mel);
+            }
+            {
+                SIGNALFLOW_INSTRUMENT_SCOPE(instrument::Stage::Callback);
+                on_frame(state.owners[r], std::span<const float>(mel));
+            }
+            SIGNALFLOW_INSTRUMENT_FRAME();
+        }
+        state.frames += state.rows;
+        state.rows = 0;
+    }
+
+    Stream& checked(StreamId id) const {
+        if (id >= streams_.size() || !streams_[id]) {
+            throw std::out_of_range("StreamEngine: unknown stream id");
+        }
+        return *streams_[id];
+    }
+
+    size_t n_fft_;
+    size_t hop_size_;
+    size_t stream_capacity_;
+    // Shared, read-only plans (the FFT plan is shared through the plan cache)
+    Window window_;
+    MelFilterBank mel_bank_;
+    std::optional<LogMelOptions> log_mel_;
+    bool power_ = false;
+    ThreadPool pool_;
+    std::vector<Worker> workers_;
+    std::vector<std::unique_ptr<Stream>> streams_;
+    std::vector<StreamId> free_ids_;
+};
+
+}
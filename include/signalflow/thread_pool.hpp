@@ -0,0 +1,197 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace signalflow {
+
+// Fixed-size worker pool for data-parallel loops. Each worker has a stable index in
+// [0, size()), so callers can keep per-worker state (FFT instances, scratch) in a
+// plain vector without any locking.
+class ThreadPool {
+public:
+    // threads == 0 uses one worker per hardware thread
+    explicit ThreadPool(size_t threads = 0) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        workers_.reserve(threads);
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this, i] { run(i); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers_.size(); }
+
+    // Calls fn(begin, end, worker) over [0, count) in chunks of at most grain items and
+    // blocks until every chunk is done. Chunks are claimed dynamically, so uneven work
+    // balances itself. The first exception thrown by fn is rethrown here.
+    template <typename F>
+    void parallel_for(size_t count, size_t grain, F&& fn) {
+        if (count == 0) return;
+        grain = std::max<size_t>(grain, 1);
+
+        std::lock_guard submit(submit_mutex_); // One loop at a time
+        std::atomic<size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        std::function<void(size_t)> body = [&](size_t worker) {
+            for (;;) {
+                size_t begin = next.fetch_add(grain, std::memory_order_relaxed);
+                if (begin >= count) return;
+                try {
+                    fn(begin, std::min(count, begin + grain), worker);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    next.store(count, std::memory_order_relaxed); // Stop handing out chunks
+                }
+            }
+        };
+
+        run_job(body);
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Like parallel_for, but with affinity: worker w starts on its own contiguous slice
+    // [w * count / size(), (w + 1) * count / size()) and, once that is done, steals the
+    // back half of the largest remaining slice it finds. With even load, item i lands on
+    // the same worker on every call, so per-item state stays warm in that worker's cache;
+    // uneven load still balances. Blocks until done and rethrows the first exception.
+    template <typename F>
+    void parallel_for_stealing(size_t count, size_t grain, F&& fn) {
+        if (count == 0) return;
+        if (count > UINT32_MAX) return parallel_for(count, grain, std::forward<F>(fn));
+        grain = std::max<size_t>(grain, 1);
+
+        std::lock_guard submit(submit_mutex_);
+        // Each slice is one atomic word, begin << 32 | end, so the owner taking from the
+        // front and a thief taking from the back both just compare-and-swap it
+        std::vector<Slice> slices(workers_.size());
+        for (size_t w = 0; w < slices.size(); ++w) {
+            slices[w].bounds.store(pack(w * count / slices.size(), (w + 1) * count / slices.size()),
+                                   std::memory_order_relaxed);
+        }
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        std::function<void(size_t)> body = [&](size_t worker) {
+            std::atomic<uint64_t>& own = slices[worker].bounds;
+            while (!failed.load(std::memory_order_relaxed)) {
+                uint64_t bounds = own.load(std::memory_order_acquire);
+                size_t begin = bounds >> 32, end = bounds & UINT32_MAX;
+                if (begin >= end) {
+                    if (!steal(slices, worker, grain)) return;
+                    continue;
+                }
+                size_t stop = std::min(end, begin + grain);
+                if (!own.compare_exchange_weak(bounds, pack(stop, end), std::memory_order_acq_rel)) continue;
+                try {
+                    fn(begin, stop, worker);
+                } catch (...) {
+                    std::lock_guard lock(error_mutex);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+        };
+
+        run_job(body);
+        if (error) std::rethrow_exception(error);
+    }
+
+private:
+    struct alignas(64) Slice {
+        std::atomic<uint64_t> bounds{0};
+    };
+
+    static uint64_t pack(size_t begin, size_t end) {
+        return static_cast<uint64_t>(begin) << 32 | static_cast<uint64_t>(end);
+    }
+
+    // Moves the back half of the largest other slice (all of it, if at most one grain is
+    // left) into the thief's own, empty slice. Returns false once every slice is empty.
+    static bool steal(std::vector<Slice>& slices, size_t thief, size_t grain) {
+        for (;;) {
+            size_t victim = thief, largest = 0;
+            uint64_t bounds = 0;
+            for (size_t w = 0; w < slices.size(); ++w) {
+                uint64_t b = slices[w].bounds.load(std::memory_order_acquire);
+                size_t remaining = (b >> 32) < (b & UINT32_MAX) ? (b & UINT32_MAX) - (b >> 32) : 0;
+                if (w != thief && remaining > largest) {
+                    victim = w;
+                    largest = remaining;
+                    bounds = b;
+                }
+            }
+            if (largest == 0) return false;
+
+            size_t begin = bounds >> 32, end = bounds & UINT32_MAX;
+            size_t split = largest <= grain ? begin : begin + largest / 2;
+            if (slices[victim].bounds.compare_exchange_strong(bounds, pack(begin, split), std::memory_order_acq_rel)) {
+                slices[thief].bounds.store(pack(split, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+
+    // Runs body(worker) once on every worker and waits for all of them
+    void run_job(std::function<void(size_t)>& body) {
+        std::unique_lock lock(mutex_);
+        job_ = &body;
+        running_ = workers_.size();
+        ++generation_;
+        wake_.notify_all();
+        done_.wait(lock, [this] { return running_ == 0; });
+        job_ = nullptr;
+    }
+
+    void run(size_t worker) {
+        size_t seen = 0;
+        for (;;) {
+            std::function<void(size_t)>* job;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+                job = job_;
+            }
+            (*job)(worker);
+            {
+                std::lock_guard lock(mutex_);
+                if (--running_ == 0) done_.notify_one();
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex submit_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::function<void(size_t)>* job_ = nullptr;
+    size_t generation_ = 0;
+    size_t running_ = 0;
+    bool stop_ = false;
+};
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "dr_wav.h"
+
+namespace signalflow {
+
+// Streams a WAV file as mono float chunks without loading it into memory. The file
+// is memory-mapped and dr_wav parses the header in place. 16-bit PCM and 32-bit float
+// data are then converted and down-mixed straight out of the mapping, with the
+// int16 -> float step done by the SIMD kernels. Other encodings are decoded by dr_wav
+// one chunk at a time. Either way memory use is constant in the file size.
+class WavReader {
+public:
+    // Throws std::runtime_error if the file cannot be mapped or is not a valid WAV
+    explicit WavReader(const std::string& path);
+    ~WavReader();
+
+    WavReader(const WavReader&) = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    // Reads up to out.size() frames, down-mixed to mono. Returns the number of frames
+    // written, which is 0 once the end of the file is reached.
+    size_t read(std::span<float> out);
+
+    unsigned channels() const { return wav_.channels; }
+    unsigned sample_rate() const { return wav_.sampleRate; }
+    uint64_t total_frames() const { return total_frames_; }
+    uint64_t position() const { return position_; }
+
+private:
+    // How sample data gets from the mapping to float
+    enum class Source { Pcm16, Float32, Decode };
+
+    void close();
+
+    const unsigned char* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    drwav wav_{};
+    bool wav_open_ = false;
+    Source source_ = Source::Decode;
+    const unsigned char* samples_ = nullptr; // Start of the data chunk in the mapping
+    uint64_t total_frames_ = 0;
+    uint64_t position_ = 0;
+    std::vector<float> scratch_; // Interleaved chunk for the Decode path
+};
+
+}
@@ -1,9 +1,15 @@
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <span>
+#include <stdexcept>
 #include <cmath>
 #include <numbers> 
 #include <concepts>
+#include <memory_resource>
+#include <signalflow/aligned.hpp>
 #include <signalflow/buffer.hpp>
+#include <signalflow/constexpr_math.hpp>
 
 namespace signalflow {
 
@@ -11,40 +17,104 @@ class Window {
 public:
     enum class Type { Hann, Hamming };
 
-    // Constructor: pre-computes the 'curve'
-    explicit Window(size_t size, Type type = Type::Hann) : size_(size) {
+    // Constructor: pre-computes the 'curve'. Coefficients live in resource when given.
+    explicit Window(size_t size, Type type = Type::Hann, std::pmr::memory_resource* resource = nullptr)
+        : size_(size), coefficients_(AlignedAllocator<float>(resource)) {
         coefficients_.reserve(size_);
 
         for (size_t i = 0; i < size_; ++i) {
-            double weight = 0.0;
-            double angle = (2.0 * std::numbers::pi * i) / (size_ - 1);
+            coefficients_.push_back(coefficient(i, size_, type));
+        }
+    }
+
+    // Weight i of a window of the given size. constexpr so compile-time pipelines
+    // (StaticMelPipeline) can build their tables: constant evaluation goes through the
+    // series in constexpr_math.hpp, run time through <cmath>, so the two paths may differ
+    // in the last bit.
+    static constexpr float coefficient(size_t i, size_t size, Type type) {
+        if (size <= 1) return 1.0f; // A single-sample window passes the sample through
+        double weight = 0.0;
+        double angle = (2.0 * std::numbers::pi * i) / (size - 1);
+        double cos_angle;
+        if consteval {
+            cos_angle = detail::cos(angle);
+        } else {
+            cos_angle = std::cos(angle);
+        }
 
-            if (type == Type::Hann) {
-                weight = 0.5 * (1.0 - std::cos(angle));
-            } else if (type == Type::Hamming) {
-                // Hamming is slightly different: 0.54 and 0.46 are standard constants
-                weight = 0.54 - 0.46 * std::cos(angle);
-            }
-            coefficients_.push_back(static_cast<float>(weight));
+        if (type == Type::Hann) {
+            weight = 0.5 * (1.0 - cos_angle);
+        } else if (type == Type::Hamming) {
+            // Hamming is slightly different: 0.54 and 0.46 are standard constants
+            weight = 0.54 - 0.46 * cos_angle;
         }
+        return static_cast<float>(weight);
     }
 
     // This takes data from the buffer and applies the weights
     template <Numeric T>
-    std::vector<float> apply(const CircularBuffer<T>& buffer) {
+    std::vector<float> apply(const CircularBuffer<T>& buffer) const {
         std::vector<float> output(size_);
-        for (size_t i = 0; i < size_; i++) {
-            // Multiply the buffer value by the pre-computed weight
-            // Note: buffer.at(0) is the newewst, but we want to window from oldest to newest
-            // hence we use (size_ - 1 - i)
-            output[i] = static_cast<float>(buffer.at(size_ - 1 - i)) * coefficients_[i];
-        }
+        apply(buffer, output);
         return output;
     }
 
+    // Same as above, but writes into a caller-owned buffer of at least size() floats.
+    // Reads the buffer's two contiguous segments directly, so the multiply loops are
+    // branch-free and vectorize. If fewer than size() samples have been pushed, the
+    // missing (oldest) positions are zero.
+    template <Numeric T>
+    void apply(const CircularBuffer<T>& buffer, std::span<float> output) const {
+        if (output.size() < size_) {
+            throw std::invalid_argument("Window: output span too small");
+        }
+        if (buffer.capacity() < size_) {
+            throw std::out_of_range("Window: buffer is smaller than the window");
+        }
+        // Window the newest size_ samples, oldest first
+        auto [older, newer] = buffer.segments();
+        size_t available = std::min(buffer.size(), size_);
+        size_t from_newer = std::min(available, newer.size());
+        size_t from_older = available - from_newer;
+        size_t pad = size_ - available;
+
+        std::fill_n(output.data(), pad, 0.0f);
+        multiply(older.data() + older.size() - from_older, coefficients_.data() + pad,
+                 output.data() + pad, from_older);
+        multiply(newer.data() + newer.size() - from_newer, coefficients_.data() + pad + from_older,
+                 output.data() + pad + from_older, from_newer);
+    }
+
+    // Windows a frame that is already contiguous (oldest sample first), e.g. a slice of a whole signal
+    void apply(std::span<const float> frame, std::span<float> output) const {
+        if (frame.size() < size_ || output.size() < size_) {
+            throw std::invalid_argument("Window: frame or output span too small");
+        }
+        multiply(frame.data(), coefficients_.data(), output.data(), size_);
+    }
+
+    // Windows a frame split at a wrap point (e.g. SpscRing::readable()): older holds the
+    // first older.size() samples and newer the rest, size() in total
+    void apply(std::span<const float> older, std::span<const float> newer, std::span<float> output) const {
+        if (older.size() + newer.size() != size_ || output.size() < size_) {
+            throw std::invalid_argument("Window: segments must total size() and output must hold size()");
+        }
+        multiply(older.data(), coefficients_.data(), output.data(), older.size());
+        multiply(newer.data(), coefficients_.data() + older.size(), output.data() + older.size(), newer.size());
+    }
+
+    size_t size() const { return size_; }
+
 private:
+    template <Numeric T>
+    static void multiply(const T* __restrict in, const float* __restrict coeffs, float* __restrict out, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<float>(in[i]) * coeffs[i];
+        }
+    }
+
     size_t size_;
-    std::vector<float> coefficients_;
+    AlignedVector<float> coefficients_;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,111 @@
+#!/usr/bin/env python3
+"""Compare two signalflow_bench JSON runs and flag regressions.
+
+Produce the inputs with the bench_json target (or signalflow_bench
+--benchmark_out=run.json --benchmark_out_format=json), then:
+
+    scripts/compare_bench.py baseline.json current.json [--threshold 10] [--filter REGEX]
+
+Benchmarks reporting audio_s_per_s are compared on that throughput (higher is
+better); all others on real time per iteration (lower is better). When a run has
+repetition aggregates, the median is used. Exits with status 1 if any benchmark
+regressed by more than the threshold, in percent.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+THROUGHPUT = "audio_s_per_s"
+
+
+def load(path):
+    """Returns {name: (value, higher_is_better)} for one run."""
+    with open(path) as f:
+        run = json.load(f)
+
+    rows = {}
+    has_median = {}
+    for b in run["benchmarks"]:
+        name = b.get("run_name", b["name"])
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") != "median":
+                continue
+            has_median[name] = True
+        elif has_median.get(name):
+            continue
+        rows.setdefault(name, []).append(b)
+
+    results = {}
+    for name, entries in rows.items():
+        medians = [b for b in entries if b.get("run_type") == "aggregate"]
+        entries = medians or entries
+        if THROUGHPUT in entries[0]:
+            value = sum(b[THROUGHPUT] for b in entries) / len(entries)
+            results[name] = (value, True)
+        else:
+            value = sum(b["real_time"] * TIME_UNITS[b.get("time_unit", "ns")] for b in entries) / len(entries)
+            results[name] = (value, False)
+    return results
+
+
+def format_value(value, higher_is_better):
+    if higher_is_better:
+        return f"{value:,.1f} s/s"
+    for unit in ("s", "ms", "us"):
+        if value >= TIME_UNITS[unit]:
+            return f"{value / TIME_UNITS[unit]:.3f} {unit}"
+    return f"{value:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regression threshold in percent (default 10)")
+    parser.add_argument("--filter", default=None, help="only compare benchmarks matching this regex")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    pattern = re.compile(args.filter) if args.filter else None
+
+    names = [n for n in baseline if n in current and (pattern is None or pattern.search(n))]
+    if not names:
+        print("no benchmarks in common", file=sys.stderr)
+        return 1
+
+    width = max(len(n) for n in names)
+    print(f"{'benchmark':<{width}}  {'baseline':>14}  {'current':>14}  {'change':>8}")
+    regressions = []
+    for name in names:
+        old, higher_is_better = baseline[name]
+        new, _ = current[name]
+        # Positive change is always an improvement
+        if higher_is_better:
+            change = (new - old) / old * 100.0
+        else:
+            change = (old - new) / new * 100.0
+        flag = ""
+        if change < -args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        print(f"{name:<{width}}  {format_value(old, higher_is_better):>14}  "
+              f"{format_value(new, higher_is_better):>14}  {change:+7.1f}%{flag}")
+
+    for name in sorted(set(baseline) ^ set(current)):
+        if pattern is not None and not pattern.search(name):
+            continue
+        print(f"{name}: only in {'baseline' if name in baseline else 'current'}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold:g}%")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
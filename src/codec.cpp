@@ -0,0 +1,454 @@
+// Mel frame codec: float16 conversion, per-frame int8 quantisation and delta + varint
+// coding. Vector kernels follow simd.cpp: per-function target attributes with runtime
+// dispatch, and scalar code that reproduces them exactly.
+
+#include <signalflow/codec.hpp>
+#include <signalflow/simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIGNALFLOW_CODEC_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define SIGNALFLOW_CODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace signalflow {
+
+namespace {
+
+// Largest |code| for DeltaVarint: exactly representable as a float, and the difference
+// of two codes still fits in an int32
+constexpr float kMaxCode = 1073741760.0f; // 2^30 - 64
+constexpr size_t kMaxVarintBytes = 5;
+constexpr size_t kInt8HeaderBytes = 2 * sizeof(float);
+
+bool use_avx2() {
+    return simd::supported(simd::Level::AVX2);
+}
+
+// --- Scalar kernels ----------------------------------------------------------------
+
+uint16_t float_to_half_scalar(float f) {
+    uint32_t x = std::bit_cast<uint32_t>(f);
+    uint32_t sign = (x >> 16) & 0x8000u;
+    uint32_t abs = x & 0x7fffffffu;
+    if (abs >= 0x7f800000u) {
+        // Infinity, or NaN made quiet with the top payload bits kept
+        return static_cast<uint16_t>(sign | 0x7c00u | (abs > 0x7f800000u ? 0x200u | ((abs >> 13) & 0x3ffu) : 0u));
+    }
+    if (abs >= 0x477ff000u) {
+        return static_cast<uint16_t>(sign | 0x7c00u); // Rounds to 65520 or more: overflow
+    }
+    if (abs < 0x38800000u) {
+        // Below the smallest normal half: multiples of 2^-24, rounded to nearest even
+        long units = std::lrint(std::bit_cast<float>(abs) * 16777216.0f);
+        return static_cast<uint16_t>(sign | static_cast<uint32_t>(units));
+    }
+    // Rebias the exponent (127 -> 15) and round the mantissa from 23 to 10 bits, ties to even
+    uint32_t h = abs - 0x38000000u;
+    h = (h + 0xfffu + ((h >> 13) & 1u)) >> 13;
+    return static_cast<uint16_t>(sign | h);
+}
+
+float half_to_float_scalar(uint16_t h) {
+    uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+    uint32_t exponent = (h >> 10) & 0x1fu;
+    uint32_t mantissa = h & 0x3ffu;
+    if (exponent == 0) {
+        float value = static_cast<float>(mantissa) * 5.9604644775390625e-8f; // 2^-24
+        return sign ? -value : value;
+    }
+    if (exponent == 31) {
+        return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+void min_max_scalar(const float* in, size_t n, float& lo, float& hi) {
+    for (size_t i = 0; i < n; ++i) {
+        lo = in[i] < lo ? in[i] : lo;
+        hi = in[i] > hi ? in[i] : hi;
+    }
+}
+
+// q = round((x - lo) * inv) clamped to [0, 255]
+void quantize_u8_scalar(const float* in, uint8_t* out, size_t n, float lo, float inv) {
+    for (size_t i = 0; i < n; ++i) {
+        float v = (in[i] - lo) * inv;
+        v = v < 255.0f ? v : 255.0f;
+        long q = std::lrint(v);
+        out[i] = static_cast<uint8_t>(q < 0 ? 0 : q);
+    }
+}
+
+// c = round(x * inv) clamped to +-kMaxCode
+void quantize_i32_scalar(const float* in, int32_t* out, size_t n, float inv) {
+    for (size_t i = 0; i < n; ++i) {
+        float v = in[i] * inv;
+        v = v > -kMaxCode ? v : -kMaxCode;
+        v = v < kMaxCode ? v : kMaxCode;
+        out[i] = static_cast<int32_t>(std::lrint(v));
+    }
+}
+
+#if SIGNALFLOW_CODEC_X86
+
+bool has_f16c() {
+    static const bool supported = __builtin_cpu_supports("f16c") && use_avx2();
+    return supported;
+}
+
+__attribute__((target("avx2,f16c")))
+void float_to_half_f16c(const float* in, uint16_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), h);
+    }
+    for (; i < n; ++i) out[i] = float_to_half_scalar(in[i]);
+}
+
+__attribute__((target("avx2,f16c")))
+void half_to_float_f16c(const uint16_t* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+    }
+    for (; i < n; ++i) out[i] = half_to_float_scalar(in[i]);
+}
+
+// min_ps/max_ps return their second operand when either is NaN, so with the accumulator
+// second a NaN input leaves it alone, exactly as the scalar comparisons do
+__attribute__((target("avx2")))
+void min_max_avx2(const float* in, size_t n, float& lo, float& hi) {
+    size_t i = 0;
+    if (n >= 8) {
+        __m256 vlo = _mm256_set1_ps(lo), vhi = _mm256_set1_ps(hi);
+        for (; i + 8 <= n; i += 8) {
+            __m256 v = _mm256_loadu_ps(in + i);
+            vlo = _mm256_min_ps(v, vlo);
+            vhi = _mm256_max_ps(v, vhi);
+        }
+        alignas(32) float l[8], h[8];
+        _mm256_store_ps(l, vlo);
+        _mm256_store_ps(h, vhi);
+        // Each accumulator only feeds its own bound: a lane that saw nothing but NaNs
+        // still holds the other bound's infinity
+        for (int k = 0; k < 8; ++k) {
+            lo = l[k] < lo ? l[k] : lo;
+            hi = h[k] > hi ? h[k] : hi;
+        }
+    }
+    min_max_scalar(in + i, n - i, lo, hi);
+}
+
+// No fma in the target, so (x - lo) * inv rounds exactly as the scalar code does
+__attribute__((target("avx2")))
+void quantize_u8_avx2(const float* in, uint8_t* out, size_t n, float lo, float inv) {
+    const __m256 vlo = _mm256_set1_ps(lo), vinv = _mm256_set1_ps(inv), top = _mm256_set1_ps(255.0f);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i), vlo), vinv), top);
+        __m256 b = _mm256_min_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(in + i + 8), vlo), vinv), top);
+        // Saturating packs clamp negatives to 0; they work per 128-bit lane, so restore order
+        __m256i words = _mm256_packus_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        words = _mm256_permute4x64_epi64(words, 0xD8);
+        __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+    quantize_u8_scalar(in + i, out + i, n - i, lo, inv);
+}
+
+__attribute__((target("avx2")))
+void quantize_i32_avx2(const float* in, int32_t* out, size_t n, float inv) {
+    const __m256 vinv = _mm256_set1_ps(inv);
+    const __m256 lo = _mm256_set1_ps(-kMaxCode), hi = _mm256_set1_ps(kMaxCode);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_mul_ps(_mm256_loadu_ps(in + i), vinv);
+        v = _mm256_min_ps(_mm256_max_ps(v, lo), hi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvtps_epi32(v));
+    }
+    quantize_i32_scalar(in + i, out + i, n - i, inv);
+}
+
+#endif // SIGNALFLOW_CODEC_X86
+
+void quantize_u8(const float* in, uint8_t* out, size_t n, float lo, float inv) {
+#if SIGNALFLOW_CODEC_X86
+    if (use_avx2()) return quantize_u8_avx2(in, out, n, lo, inv);
+#endif
+    quantize_u8_scalar(in, out, n, lo, inv);
+}
+
+void quantize_i32(const float* in, int32_t* out, size_t n, float inv) {
+#if SIGNALFLOW_CODEC_X86
+    if (use_avx2()) return quantize_i32_avx2(in, out, n, inv);
+#endif
+    quantize_i32_scalar(in, out, n, inv);
+}
+
+// --- Byte packing (little-endian on the wire) ----------------------------------------
+
+void put_float(uint8_t* p, float value) {
+    uint32_t bits = std::bit_cast<uint32_t>(value);
+    for (int b = 0; b < 4; ++b) p[b] = static_cast<uint8_t>(bits >> (8 * b));
+}
+
+float get_float(const uint8_t* p) {
+    uint32_t bits = 0;
+    for (int b = 0; b < 4; ++b) bits |= static_cast<uint32_t>(p[b]) << (8 * b);
+    return std::bit_cast<float>(bits);
+}
+
+void put_halves(uint8_t* p, const uint16_t* halves, size_t n) {
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(p, halves, n * sizeof(uint16_t));
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            p[2 * i] = static_cast<uint8_t>(halves[i]);
+            p[2 * i + 1] = static_cast<uint8_t>(halves[i] >> 8);
+        }
+    }
+}
+
+void get_halves(const uint8_t* p, uint16_t* halves, size_t n) {
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(halves, p, n * sizeof(uint16_t));
+    } else {
+        for (size_t i = 0; i < n; ++i) halves[i] = static_cast<uint16_t>(p[2 * i] | (p[2 * i + 1] << 8));
+    }
+}
+
+// Zigzag maps small magnitudes of either sign to small unsigned values, then LEB128
+// stores 7 bits per byte with the high bit marking continuation
+size_t put_varint(uint8_t* p, int32_t value) {
+    uint32_t u = (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+    size_t len = 0;
+    while (u >= 0x80u) {
+        p[len++] = static_cast<uint8_t>(u | 0x80u);
+        u >>= 7;
+    }
+    p[len++] = static_cast<uint8_t>(u);
+    return len;
+}
+
+int32_t get_varint(std::span<const uint8_t> in, size_t& pos) {
+    uint32_t u = 0;
+    for (size_t i = 0; i < kMaxVarintBytes; ++i) {
+        if (pos >= in.size()) {
+            throw std::invalid_argument("MelCodec: truncated input");
+        }
+        uint8_t byte = in[pos++];
+        u |= static_cast<uint32_t>(byte & 0x7fu) << (7 * i);
+        if (!(byte & 0x80u)) {
+            return static_cast<int32_t>(u >> 1) ^ -static_cast<int32_t>(u & 1u);
+        }
+    }
+    throw std::invalid_argument("MelCodec: malformed varint");
+}
+
+}
+
+namespace codec {
+
+void float_to_half(const float* in, uint16_t* out, size_t n) {
+#if SIGNALFLOW_CODEC_X86
+    if (has_f16c()) return float_to_half_f16c(in, out, n);
+#elif SIGNALFLOW_CODEC_NEON
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+    }
+    in += i; out += i; n -= i;
+#endif
+    for (size_t i = 0; i < n; ++i) out[i] = float_to_half_scalar(in[i]);
+}
+
+void min_max(const float* in, size_t n, float& lo, float& hi, simd::Level level) {
+    lo = std::numeric_limits<float>::infinity();
+    hi = -std::numeric_limits<float>::infinity();
+#if SIGNALFLOW_CODEC_X86
+    if (level != simd::Level::Scalar && use_avx2()) {
+        min_max_avx2(in, n, lo, hi);
+    } else {
+        min_max_scalar(in, n, lo, hi);
+    }
+#else
+    static_cast<void>(level);
+    min_max_scalar(in, n, lo, hi);
+#endif
+    // Which zero survives depends on the visiting order; +0 either way
+    lo += 0.0f;
+    hi += 0.0f;
+}
+
+void half_to_float(const uint16_t* in, float* out, size_t n) {
+#if SIGNALFLOW_CODEC_X86
+    if (has_f16c()) return half_to_float_f16c(in, out, n);
+#elif SIGNALFLOW_CODEC_NEON
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + i))));
+    }
+    in += i; out += i; n -= i;
+#endif
+    for (size_t i = 0; i < n; ++i) out[i] = half_to_float_scalar(in[i]);
+}
+
+}
+
+MelCodec::MelCodec(size_t n_mels, MelEncoding encoding, float step)
+    : n_mels_(n_mels), encoding_(encoding), step_(step) {
+    if (n_mels_ == 0) {
+        throw std::invalid_argument("MelCodec: n_mels must be positive");
+    }
+    if (!(step_ > 0.0f) || !std::isfinite(step_)) {
+        throw std::invalid_argument("MelCodec: step must be positive");
+    }
+}
+
+size_t MelCodec::max_encoded_size(size_t frames) const {
+    switch (encoding_) {
+        case MelEncoding::Float16: return frames * n_mels_ * sizeof(uint16_t);
+        case MelEncoding::Int8: return frames * (kInt8HeaderBytes + n_mels_);
+        case MelEncoding::DeltaVarint: return frames * n_mels_ * kMaxVarintBytes;
+    }
+    return 0;
+}
+
+MelEncodeStats MelCodec::encode(std::span<const float> frames, std::vector<uint8_t>& out) const {
+    if (frames.size() % n_mels_ != 0) {
+        throw std::invalid_argument("MelCodec: input is not a whole number of frames");
+    }
+    const size_t count = frames.size() / n_mels_;
+    const size_t start = out.size();
+    out.resize(start + max_encoded_size(count));
+    uint8_t* p = out.data() + start;
+    MelEncodeStats stats;
+
+    switch (encoding_) {
+        case MelEncoding::Float16: {
+            // Convert in small blocks so the halves stay in L1 on their way to the output
+            uint16_t halves[256];
+            for (size_t i = 0; i < frames.size(); i += 256) {
+                size_t n = std::min<size_t>(256, frames.size() - i);
+                codec::float_to_half(frames.data() + i, halves, n);
+                put_halves(p + 2 * i, halves, n);
+            }
+            float lo, hi;
+            codec::min_max(frames.data(), frames.size(), lo, hi);
+            float largest = std::max(std::abs(lo), std::abs(hi));
+            stats.max_error = largest >= 65520.0f ? std::numeric_limits<float>::infinity()
+                                                  : std::max(largest * 0x1p-11f, 0x1p-25f);
+            p += frames.size() * sizeof(uint16_t);
+            break;
+        }
+        case MelEncoding::Int8: {
+            for (size_t f = 0; f < count; ++f) {
+                const float* row = frames.data() + f * n_mels_;
+                float lo, hi;
+                codec::min_max(row, n_mels_, lo, hi);
+                float scale = (hi - lo) / 255.0f;
+                float inv = hi > lo ? 255.0f / (hi - lo) : 0.0f;
+                put_float(p, lo);
+                put_float(p + 4, scale);
+                quantize_u8(row, p + kInt8HeaderBytes, n_mels_, lo, inv);
+                p += kInt8HeaderBytes + n_mels_;
+                // Half a step, plus the float rounding in quantising and reconstructing;
+                // a constant frame decodes exactly
+                float bound = hi > lo ? 0.5f * scale + (std::abs(lo) + std::abs(hi)) * 0x1p-21f : 0.0f;
+                stats.max_error = std::max(stats.max_error, bound);
+            }
+            break;
+        }
+        case MelEncoding::DeltaVarint: {
+            std::vector<int32_t> codes(2 * n_mels_, 0);
+            int32_t* previous = codes.data();
+            int32_t* current = codes.data() + n_mels_;
+            for (size_t f = 0; f < count; ++f) {
+                quantize_i32(frames.data() + f * n_mels_, current, n_mels_, 1.0f / step_);
+                for (size_t m = 0; m < n_mels_; ++m) {
+                    p += put_varint(p, current[m] - previous[m]);
+                }
+                std::swap(previous, current);
+            }
+            float lo, hi;
+            codec::min_max(frames.data(), frames.size(), lo, hi);
+            float largest = std::max(std::abs(lo), std::abs(hi));
+            stats.max_error = largest / step_ >= kMaxCode ? std::numeric_limits<float>::infinity()
+                                                          : 0.5f * step_ + largest * 0x1p-21f;
+            break;
+        }
+    }
+
+    stats.bytes = static_cast<size_t>(p - (out.data() + start));
+    out.resize(start + stats.bytes);
+    return stats;
+}
+
+size_t MelCodec::decode(std::span<const uint8_t> in, std::span<float> out) const {
+    if (out.size() % n_mels_ != 0) {
+        throw std::invalid_argument("MelCodec: output is not a whole number of frames");
+    }
+    const size_t count = out.size() / n_mels_;
+
+    switch (encoding_) {
+        case MelEncoding::Float16: {
+            size_t bytes = out.size() * sizeof(uint16_t);
+            if (in.size() < bytes) {
+                throw std::invalid_argument("MelCodec: truncated input");
+            }
+            uint16_t halves[256];
+            for (size_t i = 0; i < out.size(); i += 256) {
+                size_t n = std::min<size_t>(256, out.size() - i);
+                get_halves(in.data() + 2 * i, halves, n);
+                codec::half_to_float(halves, out.data() + i, n);
+            }
+            return bytes;
+        }
+        case MelEncoding::Int8: {
+            size_t bytes = count * (kInt8HeaderBytes + n_mels_);
+            if (in.size() < bytes) {
+                throw std::invalid_argument("MelCodec: truncated input");
+            }
+            const uint8_t* p = in.data();
+            for (size_t f = 0; f < count; ++f) {
+                float lo = get_float(p);
+                float scale = get_float(p + 4);
+                const uint8_t* q = p + kInt8HeaderBytes;
+                float* row = out.data() + f * n_mels_;
+                for (size_t m = 0; m < n_mels_; ++m) {
+                    row[m] = lo + static_cast<float>(q[m]) * scale;
+                }
+                p += kInt8HeaderBytes + n_mels_;
+            }
+            return bytes;
+        }
+        case MelEncoding::DeltaVarint: {
+            std::vector<int32_t> codes(n_mels_, 0);
+            size_t pos = 0;
+            for (size_t f = 0; f < count; ++f) {
+                float* row = out.data() + f * n_mels_;
+                for (size_t m = 0; m < n_mels_; ++m) {
+                    // Unsigned wraparound keeps malformed input defined
+                    codes[m] = static_cast<int32_t>(static_cast<uint32_t>(codes[m]) +
+                                                    static_cast<uint32_t>(get_varint(in, pos)));
+                    row[m] = static_cast<float>(codes[m]) * step_;
+                }
+            }
+            return pos;
+        }
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,3 @@
+/* Single translation unit holding the dr_wav implementation for the library */
+#define DR_WAV_IMPLEMENTATION
+#include "dr_wav.h"
@@ -0,0 +1,390 @@
+// signalflow_extract: batch mel feature extraction for dataset preparation.
+// Worker threads each take the next input and stream it: fixed-size chunks from WavReader
+// go straight into a MelSpectrogram, and each chunk's frames are appended to the feature
+// file (feature_file.hpp) as they are produced. Memory per worker is constant whatever the
+// file length, and files are processed in parallel, one per worker.
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../include/signalflow/mel_spectrogram.hpp"
+#include "../../include/signalflow/wav_reader.hpp"
+#include "../../include/signalflow/feature_file.hpp"
+#include "../../include/signalflow/instrument.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* kUsage =
+    "Usage: signalflow_extract [options] <input>...\n"
+    "\n"
+    "Inputs are WAV files, directories (searched recursively for *.wav) or @list files\n"
+    "holding one input per line. Each file's features go to <output>/<path>.mel, where\n"
+    "<path> is relative to the directory argument (to the working directory for files).\n"
+    "\n"
+    "Options:\n"
+    "  -o, --output DIR   Output directory (default: features)\n"
+    "  --n-fft N          FFT size (default: 1024)\n"
+    "  --hop N            Hop size (default: 512)\n"
+    "  --mels N           Mel bands (default: 40)\n"
+    "  --fmin HZ          Lowest filter edge (default: 0)\n"
+    "  --fmax HZ          Highest filter edge, clamped to Nyquist (default: 8000)\n"
+    "  --log              Natural-log power mel features\n"
+    "  --db               Decibel power mel features\n"
+    "  --float16          Store float16 instead of float32\n"
+    "  --workers N        Files extracted at once (default: one per hardware thread)\n";
+
+struct Options {
+    std::vector<std::string> inputs;
+    fs::path output = "features";
+    size_t n_fft = 1024;
+    size_t hop = 512;
+    size_t n_mels = 40;
+    float f_min = 0.0f;
+    float f_max = 8000.0f;
+    std::optional<signalflow::LogMelOptions> log_mel;
+    bool float16 = false;
+    size_t workers = std::max(1u, std::thread::hardware_concurrency());
+};
+
+struct UsageError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+size_t parse_count(const std::string& flag, const std::string& value) {
+    size_t pos = 0;
+    unsigned long n = 0;
+    try {
+        n = std::stoul(value, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (pos != value.size() || n == 0) throw UsageError(flag + " needs a positive integer");
+    return n;
+}
+
+float parse_hz(const std::string& flag, const std::string& value) {
+    size_t pos = 0;
+    float hz = 0.0f;
+    try {
+        hz = std::stof(value, &pos);
+    } catch (const std::exception&) {
+        pos = 0;
+    }
+    if (pos != value.size()) throw UsageError(flag + " needs a frequency in Hz");
+    return hz;
+}
+
+Options parse_options(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw UsageError(arg + " needs a value");
+            return argv[++i];
+        };
+        if (arg == "-o" || arg == "--output") options.output = value();
+        else if (arg == "--n-fft") options.n_fft = parse_count(arg, value());
+        else if (arg == "--hop") options.hop = parse_count(arg, value());
+        else if (arg == "--mels") options.n_mels = parse_count(arg, value());
+        else if (arg == "--fmin") options.f_min = parse_hz(arg, value());
+        else if (arg == "--fmax") options.f_max = parse_hz(arg, value());
+        else if (arg == "--log") options.log_mel = signalflow::LogMelOptions{};
+        else if (arg == "--db") {
+            options.log_mel = signalflow::LogMelOptions{};
+            options.log_mel->scale = signalflow::LogMelOptions::Scale::Decibel;
+        }
+        else if (arg == "--float16") options.float16 = true;
+        else if (arg == "--workers") options.workers = parse_count(arg, value());
+        else if (arg == "-h" || arg == "--help") throw UsageError("");
+        else if (arg.size() > 1 && arg[0] == '-') throw UsageError("unknown option " + arg);
+        else options.inputs.push_back(arg);
+    }
+    if (options.inputs.empty()) throw UsageError("no inputs");
+    if (options.hop > options.n_fft) throw UsageError("--hop must not exceed --n-fft");
+    if (options.n_fft % 2 != 0) throw UsageError("--n-fft must be even");
+    return options;
+}
+
+// --- Inputs ---------------------------------------------------------------------------
+
+struct Input {
+    fs::path source;
+    fs::path output;
+};
+
+bool is_wav(const fs::path& path) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".wav";
+}
+
+class InputList {
+public:
+    explicit InputList(fs::path output) : output_(std::move(output)), cwd_(fs::current_path()) {}
+
+    void add(const std::string& arg) {
+        if (!arg.empty() && arg[0] == '@') {
+            std::ifstream list(arg.substr(1));
+            if (!list) throw std::runtime_error("cannot read list " + arg.substr(1));
+            for (std::string line; std::getline(list, line);) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty() && line[0] != '#') add_path(line);
+            }
+        } else {
+            add_path(arg);
+        }
+    }
+
+    std::vector<Input> take() { return std::move(inputs_); }
+
+private:
+    void add_path(const fs::path& path) {
+        if (fs::is_directory(path)) {
+            // Sorted, so runs over the same tree process files in the same order
+            std::vector<fs::path> files;
+            for (const auto& entry : fs::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file() && is_wav(entry.path())) files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end());
+            for (const auto& file : files) add_file(file, file.lexically_relative(path));
+        } else if (fs::is_regular_file(path)) {
+            fs::path relative = fs::absolute(path).lexically_normal().lexically_relative(cwd_);
+            if (relative.empty() || *relative.begin() == "..") relative = path.filename();
+            add_file(path, relative);
+        } else {
+            throw std::runtime_error("no such file or directory: " + path.string());
+        }
+    }
+
+    void add_file(const fs::path& source, fs::path relative) {
+        fs::path output = output_ / relative.replace_extension(".mel");
+        if (!outputs_.insert(output).second) {
+            throw std::runtime_error("two inputs would write " + output.string());
+        }
+        inputs_.push_back({source, output});
+    }
+
+    fs::path output_;
+    fs::path cwd_;
+    std::vector<Input> inputs_;
+    std::set<fs::path> outputs_;
+};
+
+// --- Pipeline -------------------------------------------------------------------------
+
+using Clock = std::chrono::steady_clock;
+
+struct Totals {
+    std::atomic<size_t> files{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<uint64_t> bytes_in{0};
+    std::atomic<uint64_t> bytes_out{0};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<double> audio_seconds{0.0};
+    // Time per stage, summed over the workers
+    std::atomic<int64_t> read_ns{0};
+    std::atomic<int64_t> dsp_ns{0};
+    std::atomic<int64_t> write_ns{0};
+};
+
+class Extractor {
+public:
+    // Samples decoded per step. This chunk and the rows it yields are all of a file a
+    // worker holds at once.
+    static constexpr size_t kChunkSamples = 64 * 1024;
+
+    Extractor(const Options& options, std::vector<Input> inputs)
+        : options_(options), inputs_(std::move(inputs)) {}
+
+    void run() {
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < options_.workers; ++i) threads.emplace_back([this] { work(); });
+        for (auto& thread : threads) thread.join();
+    }
+
+    const Totals& totals() const { return totals_; }
+
+private:
+    // Kept by a worker across files: one MelSpectrogram per sample rate seen, and the
+    // chunk and row buffers
+    struct Worker {
+        std::map<unsigned, std::unique_ptr<signalflow::MelSpectrogram>> pipelines;
+        std::vector<float> chunk = std::vector<float>(kChunkSamples);
+        std::vector<float> rows;
+    };
+
+    void fail(size_t index, const std::exception& e) {
+        std::lock_guard lock(log_mutex_);
+        std::cerr << "error: " << inputs_[index].source.string() << ": " << e.what() << '\n';
+        totals_.failed++;
+    }
+
+    // Adds the time since start to total and restarts the clock
+    static void add_time(std::atomic<int64_t>& total, Clock::time_point& start) {
+        auto now = Clock::now();
+        total += std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+        start = now;
+    }
+
+    // Takes inputs in order until none are left
+    void work() {
+        Worker worker;
+        for (size_t index; (index = next_input_++) < inputs_.size();) {
+            try {
+                extract(inputs_[index], worker);
+            } catch (const std::exception& e) {
+                fail(index, e);
+            }
+        }
+    }
+
+    void extract(const Input& input, Worker& worker) {
+        auto start = Clock::now();
+        signalflow::WavReader reader(input.source.string());
+        const unsigned sample_rate = reader.sample_rate();
+        add_time(totals_.read_ns, start);
+
+        auto& pipeline = worker.pipelines[sample_rate];
+        if (!pipeline) {
+            pipeline = std::make_unique<signalflow::MelSpectrogram>(
+                options_.n_fft, options_.hop, static_cast<int>(sample_rate), options_.n_mels,
+                options_.f_min, options_.f_max, signalflow::Window::Type::Hann,
+                signalflow::FFTBackend::Auto, options_.log_mel);
+        }
+        pipeline->reset();
+        add_time(totals_.dsp_ns, start);
+
+        fs::create_directories(input.output.parent_path());
+        signalflow::FeatureFileWriter output(input.output.string(), header(sample_rate));
+        add_time(totals_.write_ns, start);
+
+        uint64_t samples = 0;
+        while (size_t n = reader.read(worker.chunk)) {
+            add_time(totals_.read_ns, start);
+            samples += n;
+            worker.rows.clear();
+            pipeline->process(std::span<const float>(worker.chunk).first(n), [&](std::span<const float> mel) {
+                worker.rows.insert(worker.rows.end(), mel.begin(), mel.end());
+            });
+            add_time(totals_.dsp_ns, start);
+            output.append(worker.rows);
+            add_time(totals_.write_ns, start);
+        }
+        add_time(totals_.read_ns, start);
+        output.commit();
+        add_time(totals_.write_ns, start);
+
+        const size_t element = options_.float16 ? sizeof(uint16_t) : sizeof(float);
+        totals_.files++;
+        totals_.frames += output.frames();
+        totals_.bytes_in += fs::file_size(input.source);
+        totals_.bytes_out += sizeof(signalflow::FeatureFileHeader) + output.frames() * pipeline->n_mels() * element;
+        totals_.audio_seconds += static_cast<double>(samples) / sample_rate;
+    }
+
+    // Header fields as the filterbank actually used them (see MelFilterBank::normalize)
+    signalflow::FeatureFileHeader header(unsigned sample_rate) const {
+        auto key = signalflow::MelFilterBank::normalize(
+            {options_.n_fft, static_cast<int>(sample_rate), options_.n_mels, options_.f_min, options_.f_max});
+        signalflow::FeatureFileHeader header;
+        header.type = options_.float16 ? signalflow::FeatureType::Float16 : signalflow::FeatureType::Float32;
+        header.n_mels = static_cast<uint32_t>(key.n_mels);
+        header.sample_rate = sample_rate;
+        header.n_fft = static_cast<uint32_t>(options_.n_fft);
+        header.hop_size = static_cast<uint32_t>(options_.hop);
+        header.f_min = key.f_min;
+        header.f_max = key.f_max;
+        header.flags = options_.log_mel ? signalflow::FeatureFileHeader::kLogMel : 0;
+        return header;
+    }
+
+    const Options& options_;
+    std::vector<Input> inputs_;
+    std::atomic<size_t> next_input_{0};
+    Totals totals_;
+    std::mutex log_mutex_;
+};
+
+// Per-stage latency table, when the library was built with SIGNALFLOW_INSTRUMENT
+void print_stage_summary() {
+    if (!signalflow::instrument::enabled()) return;
+    auto snap = signalflow::instrument::snapshot();
+    std::cout << "\nStage timings over " << snap.frames << " frames (ns)\n";
+    std::cout << std::left << std::setw(12) << "stage" << std::right << std::setw(10) << "calls"
+              << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "max" << '\n';
+    std::cout << std::fixed << std::setprecision(0);
+    for (size_t s = 0; s < signalflow::instrument::kStageCount; ++s) {
+        auto stage = static_cast<signalflow::instrument::Stage>(s);
+        const auto& stats = snap[stage];
+        if (stats.count == 0) continue;
+        std::cout << std::left << std::setw(12) << signalflow::instrument::name(stage) << std::right
+                  << std::setw(10) << stats.count << std::setw(10) << stats.p50_ns
+                  << std::setw(10) << stats.p99_ns << std::setw(10) << stats.max_ns << '\n';
+    }
+}
+
+void print_summary(const Totals& totals, double wall_seconds) {
+    const double mb = 1024.0 * 1024.0;
+    double wall = std::max(wall_seconds, 1e-9);
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Extracted " << totals.files << " files";
+    if (totals.failed > 0) std::cout << " (" << totals.failed << " failed)";
+    std::cout << ": " << totals.audio_seconds / 3600.0 << " h of audio, " << totals.frames << " frames in "
+              << std::setprecision(2) << wall_seconds << " s\n";
+    std::cout << std::setprecision(1)
+              << "  throughput  " << totals.audio_seconds / wall << "x realtime, "
+              << totals.bytes_in / mb / wall << " MB/s in, " << totals.bytes_out / mb / wall << " MB/s out\n"
+              << std::setprecision(2)
+              << "  busy (s)    read " << totals.read_ns * 1e-9 << ", dsp " << totals.dsp_ns * 1e-9
+              << ", write " << totals.write_ns * 1e-9 << " (summed over the workers)\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    std::vector<Input> inputs;
+    try {
+        options = parse_options(argc, argv);
+        InputList list(options.output);
+        for (const auto& arg : options.inputs) list.add(arg);
+        inputs = list.take();
+    } catch (const UsageError& e) {
+        if (!*e.what()) { // --help
+            std::cout << kUsage;
+            return 0;
+        }
+        std::cerr << "signalflow_extract: " << e.what() << "\n\n" << kUsage;
+        return 2;
+    } catch (const std::exception& e) {
+        std::cerr << "signalflow_extract: " << e.what() << '\n';
+        return 2;
+    }
+
+    auto start = Clock::now();
+    Extractor extractor(options, std::move(inputs));
+    extractor.run();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    print_summary(extractor.totals(), seconds);
+    print_stage_summary();
+    return extractor.totals().failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,321 @@
+// Feature files: header + contiguous matrix, written atomically and read by mmap (POSIX).
+// Everything on disk is little-endian, whatever the host.
+
+#include <signalflow/feature_file.hpp>
+#include <signalflow/codec.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace signalflow {
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'F', 'M', 'E', 'L', '\0', '\0', '\0'};
+
+// --- On-disk layout (little-endian) ----------------------------------------------------
+
+void put_u32(unsigned char* p, uint32_t value) {
+    for (int b = 0; b < 4; ++b) p[b] = static_cast<unsigned char>(value >> (8 * b));
+}
+
+uint32_t get_u32(const unsigned char* p) {
+    uint32_t value = 0;
+    for (int b = 0; b < 4; ++b) value |= static_cast<uint32_t>(p[b]) << (8 * b);
+    return value;
+}
+
+void encode_header(const FeatureFileHeader& header, unsigned char* out) {
+    std::memcpy(out, header.magic, 8);
+    put_u32(out + 8, header.version);
+    put_u32(out + 12, static_cast<uint32_t>(header.type));
+    put_u32(out + 16, static_cast<uint32_t>(header.frames));
+    put_u32(out + 20, static_cast<uint32_t>(header.frames >> 32));
+    put_u32(out + 24, header.n_mels);
+    put_u32(out + 28, header.sample_rate);
+    put_u32(out + 32, header.n_fft);
+    put_u32(out + 36, header.hop_size);
+    put_u32(out + 40, std::bit_cast<uint32_t>(header.f_min));
+    put_u32(out + 44, std::bit_cast<uint32_t>(header.f_max));
+    put_u32(out + 48, header.flags);
+    std::memcpy(out + 52, header.reserved, sizeof(header.reserved));
+}
+
+FeatureFileHeader decode_header(const unsigned char* in) {
+    FeatureFileHeader header;
+    std::memcpy(header.magic, in, 8);
+    header.version = get_u32(in + 8);
+    header.type = static_cast<FeatureType>(get_u32(in + 12));
+    header.frames = get_u32(in + 16) | static_cast<uint64_t>(get_u32(in + 20)) << 32;
+    header.n_mels = get_u32(in + 24);
+    header.sample_rate = get_u32(in + 28);
+    header.n_fft = get_u32(in + 32);
+    header.hop_size = get_u32(in + 36);
+    header.f_min = std::bit_cast<float>(get_u32(in + 40));
+    header.f_max = std::bit_cast<float>(get_u32(in + 44));
+    header.flags = get_u32(in + 48);
+    std::memcpy(header.reserved, in + 52, sizeof(header.reserved));
+    return header;
+}
+
+// Copies n elements of type Word (uint16_t or uint32_t) from in to out, swapping them
+// to or from little-endian; a straight copy on little-endian hosts
+template <typename Word>
+void copy_little_endian(void* out, const void* in, size_t n) {
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(out, in, n * sizeof(Word));
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            Word word;
+            std::memcpy(&word, static_cast<const unsigned char*>(in) + i * sizeof(Word), sizeof(Word));
+            word = std::byteswap(word);
+            std::memcpy(static_cast<unsigned char*>(out) + i * sizeof(Word), &word, sizeof(Word));
+        }
+    }
+}
+
+// Writes n Words little-endian; big-endian hosts swap through a small buffer
+template <typename Word>
+bool write_words(FILE* f, const void* data, size_t n) {
+    if constexpr (std::endian::native == std::endian::little) {
+        return n == 0 || std::fwrite(data, n * sizeof(Word), 1, f) == 1;
+    } else {
+        Word buffer[1024];
+        for (size_t i = 0; i < n; i += 1024) {
+            size_t count = std::min<size_t>(1024, n - i);
+            copy_little_endian<Word>(buffer, static_cast<const Word*>(data) + i, count);
+            if (std::fwrite(buffer, count * sizeof(Word), 1, f) != 1) return false;
+        }
+        return true;
+    }
+}
+
+// Creates a temporary next to path under a name no other writer uses (pid and a counter,
+// opened exclusively), so concurrent writes of one path, from threads or processes, never
+// share it. Like fopen, the mode follows the umask.
+FILE* create_temp(const std::string& path, std::string& temp) {
+    static std::atomic<uint64_t> counter{0};
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        temp = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter++);
+        int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if (fd >= 0) {
+            if (FILE* f = ::fdopen(fd, "wb")) return f;
+            ::close(fd);
+            ::unlink(temp.c_str());
+            break;
+        }
+        if (errno != EEXIST) break;
+    }
+    throw std::runtime_error("write_feature_file: cannot create a temporary file for " + path);
+}
+
+// Makes the temporary durable before renaming it over path, and the rename durable after,
+// so a crash leaves either the old file or the complete new one. Consumes f; on failure
+// the temporary is removed and false returned.
+bool commit_temp(FILE* f, const std::string& temp, const std::string& path) {
+    bool ok = std::fflush(f) == 0 && ::fsync(::fileno(f)) == 0;
+    ok = std::fclose(f) == 0 && ok;
+    if (!ok || std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(temp.c_str());
+        return false;
+    }
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd); // Best effort: the file itself is already complete
+        ::close(fd);
+    }
+    return true;
+}
+
+template <typename Word>
+void write_file(const std::string& path, const FeatureFileHeader& header, const void* data, size_t n) {
+    std::string temp;
+    FILE* f = create_temp(path, temp);
+    unsigned char bytes[sizeof(FeatureFileHeader)];
+    encode_header(header, bytes);
+    bool ok = std::fwrite(bytes, sizeof(bytes), 1, f) == 1 && write_words<Word>(f, data, n);
+    if (!ok) {
+        std::fclose(f);
+        std::remove(temp.c_str());
+    }
+    if (!ok || !commit_temp(f, temp, path)) {
+        throw std::runtime_error("write_feature_file: cannot write " + path);
+    }
+}
+
+void check_size(const FeatureFileHeader& header, FeatureType type, size_t count) {
+    if (header.type != type || header.frames * header.n_mels != count) {
+        throw std::invalid_argument("write_feature_file: data does not match the header");
+    }
+}
+
+}
+
+void write_feature_file(const std::string& path, const FeatureFileHeader& header, std::span<const float> data) {
+    check_size(header, FeatureType::Float32, data.size());
+    write_file<uint32_t>(path, header, data.data(), data.size());
+}
+
+void write_feature_file(const std::string& path, const FeatureFileHeader& header, std::span<const uint16_t> data) {
+    check_size(header, FeatureType::Float16, data.size());
+    write_file<uint16_t>(path, header, data.data(), data.size());
+}
+
+FeatureFileWriter::FeatureFileWriter(const std::string& path, const FeatureFileHeader& header)
+    : path_(path), header_(header) {
+    if (header_.n_mels == 0) {
+        throw std::invalid_argument("FeatureFileWriter: n_mels must be positive");
+    }
+    header_.frames = 0;
+    file_ = create_temp(path_, temp_);
+    // Placeholder until commit() knows the frame count
+    unsigned char bytes[sizeof(FeatureFileHeader)];
+    encode_header(header_, bytes);
+    if (std::fwrite(bytes, sizeof(bytes), 1, file_) != 1) fail();
+}
+
+FeatureFileWriter::~FeatureFileWriter() {
+    if (file_) {
+        std::fclose(file_);
+        std::remove(temp_.c_str());
+    }
+}
+
+void FeatureFileWriter::check_rows(size_t count) const {
+    if (!file_) {
+        throw std::logic_error("FeatureFileWriter: already committed");
+    }
+    if (count % header_.n_mels != 0) {
+        throw std::invalid_argument("FeatureFileWriter: data is not a whole number of rows");
+    }
+}
+
+void FeatureFileWriter::append(std::span<const float> rows) {
+    check_rows(rows.size());
+    if (header_.type == FeatureType::Float32) {
+        if (!write_words<uint32_t>(file_, rows.data(), rows.size())) fail();
+    } else {
+        uint16_t halves[1024];
+        for (size_t i = 0; i < rows.size(); i += 1024) {
+            size_t count = std::min<size_t>(1024, rows.size() - i);
+            codec::float_to_half(rows.data() + i, halves, count);
+            if (!write_words<uint16_t>(file_, halves, count)) fail();
+        }
+    }
+    header_.frames += rows.size() / header_.n_mels;
+}
+
+void FeatureFileWriter::append(std::span<const uint16_t> rows) {
+    check_rows(rows.size());
+    if (header_.type != FeatureType::Float16) {
+        throw std::invalid_argument("FeatureFileWriter: halves given to a float32 file");
+    }
+    if (!write_words<uint16_t>(file_, rows.data(), rows.size())) fail();
+    header_.frames += rows.size() / header_.n_mels;
+}
+
+void FeatureFileWriter::commit() {
+    check_rows(0);
+    unsigned char bytes[sizeof(FeatureFileHeader)];
+    encode_header(header_, bytes);
+    if (std::fseek(file_, 0, SEEK_SET) != 0 || std::fwrite(bytes, sizeof(bytes), 1, file_) != 1) fail();
+    FILE* f = std::exchange(file_, nullptr);
+    if (!commit_temp(f, temp_, path_)) {
+        throw std::runtime_error("FeatureFileWriter: cannot write " + path_);
+    }
+}
+
+void FeatureFileWriter::fail() {
+    std::fclose(std::exchange(file_, nullptr));
+    std::remove(temp_.c_str());
+    throw std::runtime_error("FeatureFileWriter: cannot write " + path_);
+}
+
+FeatureFile::FeatureFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("FeatureFile: cannot open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FeatureFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("FeatureFile: cannot stat or too short " + path);
+    }
+    mapping_size_ = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("FeatureFile: cannot map " + path);
+    }
+    mapping_ = static_cast<const unsigned char*>(mapping);
+
+    header_ = decode_header(mapping_);
+    bool valid = std::memcmp(header_.magic, kMagic, sizeof(kMagic)) == 0 &&
+                 header_.version == FeatureFileHeader::kVersion &&
+                 (header_.type == FeatureType::Float32 || header_.type == FeatureType::Float16) &&
+                 (header_.n_mels == 0 || header_.frames <= mapping_size_ / header_.n_mels) &&
+                 mapping_size_ == sizeof(header_) + header_.data_bytes();
+    if (!valid) {
+        ::munmap(const_cast<unsigned char*>(mapping_), mapping_size_);
+        mapping_ = nullptr;
+        throw std::runtime_error("FeatureFile: not a valid feature file " + path);
+    }
+
+    // The matrix is used in place, except on big-endian hosts, which get a swapped copy
+    data_ = mapping_ + sizeof(header_);
+    if constexpr (std::endian::native != std::endian::little) {
+        swapped_.resize(header_.data_bytes());
+        if (header_.type == FeatureType::Float16) {
+            copy_little_endian<uint16_t>(swapped_.data(), data_, frames() * n_mels());
+        } else {
+            copy_little_endian<uint32_t>(swapped_.data(), data_, frames() * n_mels());
+        }
+        data_ = swapped_.data();
+    }
+}
+
+FeatureFile::~FeatureFile() {
+    if (mapping_) {
+        ::munmap(const_cast<unsigned char*>(mapping_), mapping_size_);
+    }
+}
+
+std::span<const float> FeatureFile::floats() const {
+    if (header_.type != FeatureType::Float32) {
+        throw std::logic_error("FeatureFile: matrix is not float32");
+    }
+    return {reinterpret_cast<const float*>(data_), frames() * n_mels()};
+}
+
+std::span<const uint16_t> FeatureFile::halves() const {
+    if (header_.type != FeatureType::Float16) {
+        throw std::logic_error("FeatureFile: matrix is not float16");
+    }
+    return {reinterpret_cast<const uint16_t*>(data_), frames() * n_mels()};
+}
+
+void FeatureFile::row(size_t frame, std::span<float> out) const {
+    if (frame >= frames() || out.size() < n_mels()) {
+        throw std::out_of_range("FeatureFile: row out of range or output too small");
+    }
+    if (header_.type == FeatureType::Float16) {
+        codec::half_to_float(halves().data() + frame * n_mels(), out.data(), n_mels());
+    } else {
+        std::memcpy(out.data(), floats().data() + frame * n_mels(), n_mels() * sizeof(float));
+    }
+}
+
+}
@@ -0,0 +1,634 @@
+// Real-FFT plans: the kiss_fft reference backend and the built-in Radix4 backend,
+// plus the process-wide plan cache.
+
+#include <signalflow/fft_plan.hpp>
+#include <signalflow/simd.hpp>
+#include <signalflow/aligned.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+extern "C" {
+    #include "kiss_fft.h"
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIGNALFLOW_FFT_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define SIGNALFLOW_FFT_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace signalflow {
+
+namespace {
+
+bool is_power_of_two(size_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+// ---------------------------------------------------------------------------------
+// Kiss backend: kiss_fftr's algorithm on top of a shared complex kiss_fft_cfg. The
+// complex config is read-only during a transform; the scratch kiss_fftr keeps inside
+// its own state is supplied by the caller instead, so the plan can be shared.
+
+class KissPlan final : public FFTPlan {
+public:
+    explicit KissPlan(size_t nfft, std::pmr::memory_resource* resource = nullptr)
+        : FFTPlan(nfft), half_(nfft / 2), resource_(resource), super_twiddles_(AlignedAllocator<kiss_fft_cpx>(resource)) {
+        if (nfft < 2 || nfft % 2 != 0) {
+            throw std::invalid_argument("FFT: kiss backend needs an even size");
+        }
+        if (resource_) {
+            // Ask kiss_fft how much it needs, then have it build the config in place
+            kiss_fft_alloc(static_cast<int>(half_), 0, nullptr, &cfg_bytes_);
+            void* mem = resource_->allocate(cfg_bytes_, kArenaAlignment);
+            cfg_ = kiss_fft_alloc(static_cast<int>(half_), 0, mem, &cfg_bytes_);
+        } else {
+            cfg_ = kiss_fft_alloc(static_cast<int>(half_), 0, nullptr, nullptr);
+        }
+        if (!cfg_) throw std::bad_alloc();
+
+        // Same super-twiddles as kiss_fftr_alloc
+        super_twiddles_.resize(half_ / 2);
+        for (size_t i = 0; i < half_ / 2; ++i) {
+            double phase = -3.14159265358979323846264338327 * ((double) (i + 1) / half_ + .5);
+            super_twiddles_[i].r = static_cast<float>(std::cos(phase));
+            super_twiddles_[i].i = static_cast<float>(std::sin(phase));
+        }
+    }
+
+    ~KissPlan() override {
+        if (resource_) {
+            resource_->deallocate(cfg_, cfg_bytes_, kArenaAlignment);
+        } else {
+            free(cfg_);
+        }
+    }
+
+    FFTBackend backend() const override { return FFTBackend::Kiss; }
+    size_t scratch_size() const override { return 2 * half_; }
+
+    void forward(const float* in, float* out, float* scratch) const override {
+        auto* tmp = reinterpret_cast<kiss_fft_cpx*>(scratch);
+        auto* freq = reinterpret_cast<kiss_fft_cpx*>(out);
+        const size_t ncfft = half_;
+
+        // Parallel FFT of the even and odd samples packed as real and imaginary parts
+        kiss_fft(cfg_, reinterpret_cast<const kiss_fft_cpx*>(in), tmp);
+
+        float dc_r = tmp[0].r;
+        float dc_i = tmp[0].i;
+        freq[0].r = dc_r + dc_i;
+        freq[ncfft].r = dc_r - dc_i;
+        freq[ncfft].i = freq[0].i = 0;
+
+        for (size_t k = 1; k <= ncfft / 2; ++k) {
+            kiss_fft_cpx fpk = tmp[k];
+            kiss_fft_cpx fpnk = {tmp[ncfft - k].r, -tmp[ncfft - k].i};
+            kiss_fft_cpx f1k = {fpk.r + fpnk.r, fpk.i + fpnk.i};
+            kiss_fft_cpx f2k = {fpk.r - fpnk.r, fpk.i - fpnk.i};
+            const kiss_fft_cpx& w = super_twiddles_[k - 1];
+            kiss_fft_cpx tw = {f2k.r * w.r - f2k.i * w.i, f2k.r * w.i + f2k.i * w.r};
+
+            freq[k].r = (f1k.r + tw.r) * .5f;
+            freq[k].i = (f1k.i + tw.i) * .5f;
+            freq[ncfft - k].r = (f1k.r - tw.r) * .5f;
+            freq[ncfft - k].i = (tw.i - f1k.i) * .5f;
+        }
+    }
+
+private:
+    size_t half_;
+    std::pmr::memory_resource* resource_;
+    size_t cfg_bytes_ = 0;
+    kiss_fft_cfg cfg_ = nullptr;
+    AlignedVector<kiss_fft_cpx> super_twiddles_;
+};
+
+// ---------------------------------------------------------------------------------
+// Radix4 backend. The N-point real FFT runs as an M = N/2 point complex FFT on the
+// even/odd samples, followed by the usual split into the real spectrum. The complex
+// FFT is decimation-in-time over split real/imaginary arrays:
+//   1. bit-reversed load fused with the first three radix-2 stages, as one radix-8
+//      pass whose twiddles are all trivial or +-sqrt(1/2);
+//   2. fused pairs of radix-2 stages (radix-2^2, one pass over memory per two stages),
+//      plus one plain radix-2 stage when the remaining stage count is odd;
+//   3. the split into the N/2 + 1 bins of the real input, written interleaved.
+// Every pass has an AVX2 path. Stages vectorise across the butterfly index, with
+// twiddles precomputed per stage in split layout so every load is contiguous. The
+// vector paths use the same operation order as the scalar path (no FMA), so results
+// do not depend on the CPU.
+
+constexpr float kSqrtHalf = 0.70710678118654752440f;
+
+// Radix-8 butterfly over eight points in bit-reversed order: the first three radix-2
+// stages. V is float or a vector type with element-wise operators.
+template <typename V>
+[[gnu::always_inline]] inline void radix8(V* xr, V* xi, const V& s) {
+    // Half-size 1: twiddle 1
+    for (int p = 0; p < 8; p += 2) {
+        V ar = xr[p], ai = xi[p];
+        xr[p] = ar + xr[p + 1]; xi[p] = ai + xi[p + 1];
+        xr[p + 1] = ar - xr[p + 1]; xi[p + 1] = ai - xi[p + 1];
+    }
+    // Half-size 2: twiddles 1, -i
+    for (int p = 0; p < 8; p += 4) {
+        V ar = xr[p], ai = xi[p];
+        xr[p] = ar + xr[p + 2]; xi[p] = ai + xi[p + 2];
+        xr[p + 2] = ar - xr[p + 2]; xi[p + 2] = ai - xi[p + 2];
+        V br = xr[p + 1], bi = xi[p + 1], cr = xr[p + 3], ci = xi[p + 3];
+        xr[p + 1] = br + ci; xi[p + 1] = bi - cr;
+        xr[p + 3] = br - ci; xi[p + 3] = bi + cr;
+    }
+    // Half-size 4: twiddles 1, (1 - i) sqrt(1/2), -i, -(1 + i) sqrt(1/2)
+    V t[4][2] = {
+        {xr[4], xi[4]},
+        {s * (xr[5] + xi[5]), s * (xi[5] - xr[5])},
+        {xi[6], -xr[6]},
+        {s * (xi[7] - xr[7]), -(s * (xr[7] + xi[7]))},
+    };
+    for (int p = 0; p < 4; ++p) {
+        V ar = xr[p], ai = xi[p];
+        xr[p] = ar + t[p][0]; xi[p] = ai + t[p][1];
+        xr[p + 4] = ar - t[p][0]; xi[p + 4] = ai - t[p][1];
+    }
+}
+
+// Pass 1 for M >= 8: each block of eight outputs gathers its bit-reversed inputs
+void first_pass_scalar(const float* in, float* re, float* im, size_t m, const uint32_t* reverse) {
+    for (size_t b = 0; b < m; b += 8) {
+        float xr[8], xi[8];
+        for (size_t e = 0; e < 8; ++e) {
+            xr[e] = in[2 * reverse[b + e]];
+            xi[e] = in[2 * reverse[b + e] + 1];
+        }
+        radix8(xr, xi, kSqrtHalf);
+        for (size_t e = 0; e < 8; ++e) {
+            re[b + e] = xr[e];
+            im[b + e] = xi[e];
+        }
+    }
+}
+
+// Pass 3, bins [first, M/2]: z[k] and conj(z[M-k]) combine into X[k] and X[M-k]
+void split_scalar(const float* re, const float* im, const float* wr, const float* wi,
+                  float* out, size_t m, size_t first) {
+    for (size_t k = first; k <= m / 2; ++k) {
+        float fpk_r = re[k], fpk_i = im[k];
+        float fpnk_r = re[m - k], fpnk_i = -im[m - k];
+        float f1r = fpk_r + fpnk_r, f1i = fpk_i + fpnk_i;
+        float f2r = fpk_r - fpnk_r, f2i = fpk_i - fpnk_i;
+        float twr = f2r * wr[k - 1] - f2i * wi[k - 1];
+        float twi = f2r * wi[k - 1] + f2i * wr[k - 1];
+        out[2 * k] = (f1r + twr) * .5f;
+        out[2 * k + 1] = (f1i + twi) * .5f;
+        out[2 * (m - k)] = (f1r - twr) * .5f;
+        out[2 * (m - k) + 1] = (twi - f1i) * .5f;
+    }
+}
+
+// One radix-2 stage: pairs (p, p + h) with twiddle w[j] = exp(-2 pi i j / 2h)
+void radix2_scalar(float* re, float* im, size_t n, size_t h, const float* wr, const float* wi) {
+    for (size_t b = 0; b < n; b += 2 * h) {
+        for (size_t j = 0; j < h; ++j) {
+            size_t p = b + j, q = p + h;
+            float tr = re[q] * wr[j] - im[q] * wi[j];
+            float ti = re[q] * wi[j] + im[q] * wr[j];
+            re[q] = re[p] - tr;
+            im[q] = im[p] - ti;
+            re[p] = re[p] + tr;
+            im[p] = im[p] + ti;
+        }
+    }
+}
+
+// Two radix-2 stages (half-sizes h and 2h) in one pass over blocks of 4h:
+// w1[j] = exp(-2 pi i j / 2h), w2[j] = exp(-2 pi i j / 4h), and the second-stage
+// twiddle for the upper quarter is w2[j] * (-i)
+void radix22_scalar(float* re, float* im, size_t n, size_t h,
+                    const float* w1r, const float* w1i, const float* w2r, const float* w2i) {
+    for (size_t b = 0; b < n; b += 4 * h) {
+        for (size_t j = 0; j < h; ++j) {
+            size_t i0 = b + j, i1 = i0 + h, i2 = i1 + h, i3 = i2 + h;
+            float br = re[i1] * w1r[j] - im[i1] * w1i[j];
+            float bi = re[i1] * w1i[j] + im[i1] * w1r[j];
+            float dr = re[i3] * w1r[j] - im[i3] * w1i[j];
+            float di = re[i3] * w1i[j] + im[i3] * w1r[j];
+            float y0r = re[i0] + br, y0i = im[i0] + bi;
+            float y1r = re[i0] - br, y1i = im[i0] - bi;
+            float y2r = re[i2] + dr, y2i = im[i2] + di;
+            float y3r = re[i2] - dr, y3i = im[i2] - di;
+            float cr = y2r * w2r[j] - y2i * w2i[j];
+            float ci = y2r * w2i[j] + y2i * w2r[j];
+            float er = y3r * w2r[j] - y3i * w2i[j];
+            float ei = y3r * w2i[j] + y3i * w2r[j];
+            re[i0] = y0r + cr; im[i0] = y0i + ci;
+            re[i2] = y0r - cr; im[i2] = y0i - ci;
+            re[i1] = y1r + ei; im[i1] = y1i - er;
+            re[i3] = y1r - ei; im[i3] = y1i + er;
+        }
+    }
+}
+
+#if SIGNALFLOW_FFT_X86
+
+__attribute__((target("avx2")))
+inline void cmul_avx2(__m256 ar, __m256 ai, __m256 wr, __m256 wi, __m256& outr, __m256& outi) {
+    outr = _mm256_sub_ps(_mm256_mul_ps(ar, wr), _mm256_mul_ps(ai, wi));
+    outi = _mm256_add_ps(_mm256_mul_ps(ar, wi), _mm256_mul_ps(ai, wr));
+}
+
+// h must be a multiple of 8
+__attribute__((target("avx2")))
+void radix2_avx2(float* re, float* im, size_t n, size_t h, const float* wr, const float* wi) {
+    for (size_t b = 0; b < n; b += 2 * h) {
+        for (size_t j = 0; j < h; j += 8) {
+            size_t p = b + j, q = p + h;
+            __m256 tr, ti;
+            cmul_avx2(_mm256_loadu_ps(re + q), _mm256_loadu_ps(im + q),
+                      _mm256_loadu_ps(wr + j), _mm256_loadu_ps(wi + j), tr, ti);
+            __m256 pr = _mm256_loadu_ps(re + p), pi = _mm256_loadu_ps(im + p);
+            _mm256_storeu_ps(re + q, _mm256_sub_ps(pr, tr));
+            _mm256_storeu_ps(im + q, _mm256_sub_ps(pi, ti));
+            _mm256_storeu_ps(re + p, _mm256_add_ps(pr, tr));
+            _mm256_storeu_ps(im + p, _mm256_add_ps(pi, ti));
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+void radix22_avx2(float* re, float* im, size_t n, size_t h,
+                  const float* w1r, const float* w1i, const float* w2r, const float* w2i) {
+    for (size_t b = 0; b < n; b += 4 * h) {
+        for (size_t j = 0; j < h; j += 8) {
+            size_t i0 = b + j, i1 = i0 + h, i2 = i1 + h, i3 = i2 + h;
+            __m256 t1r = _mm256_loadu_ps(w1r + j), t1i = _mm256_loadu_ps(w1i + j);
+            __m256 t2r = _mm256_loadu_ps(w2r + j), t2i = _mm256_loadu_ps(w2i + j);
+            __m256 br, bi, dr, di;
+            cmul_avx2(_mm256_loadu_ps(re + i1), _mm256_loadu_ps(im + i1), t1r, t1i, br, bi);
+            cmul_avx2(_mm256_loadu_ps(re + i3), _mm256_loadu_ps(im + i3), t1r, t1i, dr, di);
+            __m256 x0r = _mm256_loadu_ps(re + i0), x0i = _mm256_loadu_ps(im + i0);
+            __m256 x2r = _mm256_loadu_ps(re + i2), x2i = _mm256_loadu_ps(im + i2);
+            __m256 y0r = _mm256_add_ps(x0r, br), y0i = _mm256_add_ps(x0i, bi);
+            __m256 y1r = _mm256_sub_ps(x0r, br), y1i = _mm256_sub_ps(x0i, bi);
+            __m256 y2r = _mm256_add_ps(x2r, dr), y2i = _mm256_add_ps(x2i, di);
+            __m256 y3r = _mm256_sub_ps(x2r, dr), y3i = _mm256_sub_ps(x2i, di);
+            __m256 cr, ci, er, ei;
+            cmul_avx2(y2r, y2i, t2r, t2i, cr, ci);
+            cmul_avx2(y3r, y3i, t2r, t2i, er, ei);
+            _mm256_storeu_ps(re + i0, _mm256_add_ps(y0r, cr));
+            _mm256_storeu_ps(im + i0, _mm256_add_ps(y0i, ci));
+            _mm256_storeu_ps(re + i2, _mm256_sub_ps(y0r, cr));
+            _mm256_storeu_ps(im + i2, _mm256_sub_ps(y0i, ci));
+            _mm256_storeu_ps(re + i1, _mm256_add_ps(y1r, ei));
+            _mm256_storeu_ps(im + i1, _mm256_sub_ps(y1i, er));
+            _mm256_storeu_ps(re + i3, _mm256_sub_ps(y1r, ei));
+            _mm256_storeu_ps(im + i3, _mm256_add_ps(y1i, er));
+        }
+    }
+}
+
+
+__attribute__((target("avx2")))
+inline void transpose8_avx2(__m256* r) {
+    __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]), t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]), t7 = _mm256_unpackhi_ps(r[6], r[7]);
+    __m256 u0 = _mm256_shuffle_ps(t0, t2, 0x44), u1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+    __m256 u2 = _mm256_shuffle_ps(t1, t3, 0x44), u3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+    __m256 u4 = _mm256_shuffle_ps(t4, t6, 0x44), u5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+    __m256 u6 = _mm256_shuffle_ps(t5, t7, 0x44), u7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+    r[0] = _mm256_permute2f128_ps(u0, u4, 0x20); r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    r[1] = _mm256_permute2f128_ps(u1, u5, 0x20); r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    r[2] = _mm256_permute2f128_ps(u2, u6, 0x20); r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    r[3] = _mm256_permute2f128_ps(u3, u7, 0x20); r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+// Pass 1 for M >= 64. Output k = 8q + e reads input rev3(e) * M/8 + rev(q), so eight
+// blocks whose reversed indices r .. r+7 are consecutive read eight contiguous complex
+// values per element e. One vector holds element e of all eight blocks; a transpose
+// turns that back into one row per block for the store.
+__attribute__((target("avx2")))
+void first_pass_avx2(const float* in, float* re, float* im, size_t m, const uint32_t* reverse) {
+    static constexpr size_t kRev3[8] = {0, 4, 2, 6, 1, 5, 3, 7};
+    const size_t stride = m / 8;
+    const __m256 s = _mm256_set1_ps(kSqrtHalf);
+    for (size_t r = 0; r < stride; r += 8) {
+        __m256 xr[8], xi[8];
+        for (size_t e = 0; e < 8; ++e) {
+            const float* src = in + 2 * (kRev3[e] * stride + r);
+            __m256 a = _mm256_loadu_ps(src), b = _mm256_loadu_ps(src + 8);
+            // Deinterleave (re, im) pairs; the shuffle leaves 64-bit lanes in 0, 2, 1, 3 order
+            xr[e] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0x88)), 0xD8));
+            xi[e] = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, 0xDD)), 0xD8));
+        }
+        radix8(xr, xi, s);
+        transpose8_avx2(xr);
+        transpose8_avx2(xi);
+        for (size_t j = 0; j < 8; ++j) {
+            size_t q = reverse[8 * (r + j)]; // rev(8 (r + j)) = rev(r + j) over the block bits
+            _mm256_storeu_ps(re + 8 * q, xr[j]);
+            _mm256_storeu_ps(im + 8 * q, xi[j]);
+        }
+    }
+}
+
+// Pass 3 eight bins at a time; returns the first bin left for split_scalar
+__attribute__((target("avx2")))
+size_t split_avx2(const float* re, const float* im, const float* wr, const float* wi, float* out, size_t m) {
+    const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 half = _mm256_set1_ps(.5f);
+    size_t k = 1;
+    for (; k + 7 <= m / 2; k += 8) {
+        __m256 fpk_r = _mm256_loadu_ps(re + k), fpk_i = _mm256_loadu_ps(im + k);
+        __m256 fpnk_r = _mm256_permutevar8x32_ps(_mm256_loadu_ps(re + m - k - 7), reversed);
+        __m256 fpnk_i = _mm256_xor_ps(_mm256_permutevar8x32_ps(_mm256_loadu_ps(im + m - k - 7), reversed), sign);
+        __m256 f1r = _mm256_add_ps(fpk_r, fpnk_r), f1i = _mm256_add_ps(fpk_i, fpnk_i);
+        __m256 f2r = _mm256_sub_ps(fpk_r, fpnk_r), f2i = _mm256_sub_ps(fpk_i, fpnk_i);
+        __m256 twr, twi;
+        cmul_avx2(f2r, f2i, _mm256_loadu_ps(wr + k - 1), _mm256_loadu_ps(wi + k - 1), twr, twi);
+
+        // X[k .. k+7], interleaved
+        __m256 ar = _mm256_mul_ps(_mm256_add_ps(f1r, twr), half);
+        __m256 ai = _mm256_mul_ps(_mm256_add_ps(f1i, twi), half);
+        __m256 lo = _mm256_unpacklo_ps(ar, ai), hi = _mm256_unpackhi_ps(ar, ai);
+        _mm256_storeu_ps(out + 2 * k, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(out + 2 * k + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+
+        // X[M-k-7 .. M-k]: computed in descending order, so reverse before interleaving.
+        // Stored second, so at k = M/2 this value wins, as in split_scalar.
+        __m256 br = _mm256_permutevar8x32_ps(_mm256_mul_ps(_mm256_sub_ps(f1r, twr), half), reversed);
+        __m256 bi = _mm256_permutevar8x32_ps(_mm256_mul_ps(_mm256_sub_ps(twi, f1i), half), reversed);
+        lo = _mm256_unpacklo_ps(br, bi);
+        hi = _mm256_unpackhi_ps(br, bi);
+        _mm256_storeu_ps(out + 2 * (m - k - 7), _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(out + 2 * (m - k - 7) + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+    return k;
+}
+
+#endif // SIGNALFLOW_FFT_X86
+
+#if SIGNALFLOW_FFT_NEON
+
+inline void cmul_neon(float32x4_t ar, float32x4_t ai, float32x4_t wr, float32x4_t wi,
+                      float32x4_t& outr, float32x4_t& outi) {
+    outr = vsubq_f32(vmulq_f32(ar, wr), vmulq_f32(ai, wi));
+    outi = vaddq_f32(vmulq_f32(ar, wi), vmulq_f32(ai, wr));
+}
+
+// h must be a multiple of 4
+void radix2_neon(float* re, float* im, size_t n, size_t h, const float* wr, const float* wi) {
+    for (size_t b = 0; b < n; b += 2 * h) {
+        for (size_t j = 0; j < h; j += 4) {
+            size_t p = b + j, q = p + h;
+            float32x4_t tr, ti;
+            cmul_neon(vld1q_f32(re + q), vld1q_f32(im + q), vld1q_f32(wr + j), vld1q_f32(wi + j), tr, ti);
+            float32x4_t pr = vld1q_f32(re + p), pi = vld1q_f32(im + p);
+            vst1q_f32(re + q, vsubq_f32(pr, tr));
+            vst1q_f32(im + q, vsubq_f32(pi, ti));
+            vst1q_f32(re + p, vaddq_f32(pr, tr));
+            vst1q_f32(im + p, vaddq_f32(pi, ti));
+        }
+    }
+}
+
+void radix22_neon(float* re, float* im, size_t n, size_t h,
+                  const float* w1r, const float* w1i, const float* w2r, const float* w2i) {
+    for (size_t b = 0; b < n; b += 4 * h) {
+        for (size_t j = 0; j < h; j += 4) {
+            size_t i0 = b + j, i1 = i0 + h, i2 = i1 + h, i3 = i2 + h;
+            float32x4_t t1r = vld1q_f32(w1r + j), t1i = vld1q_f32(w1i + j);
+            float32x4_t t2r = vld1q_f32(w2r + j), t2i = vld1q_f32(w2i + j);
+            float32x4_t br, bi, dr, di;
+            cmul_neon(vld1q_f32(re + i1), vld1q_f32(im + i1), t1r, t1i, br, bi);
+            cmul_neon(vld1q_f32(re + i3), vld1q_f32(im + i3), t1r, t1i, dr, di);
+            float32x4_t x0r = vld1q_f32(re + i0), x0i = vld1q_f32(im + i0);
+            float32x4_t x2r = vld1q_f32(re + i2), x2i = vld1q_f32(im + i2);
+            float32x4_t y0r = vaddq_f32(x0r, br), y0i = vaddq_f32(x0i, bi);
+            float32x4_t y1r = vsubq_f32(x0r, br), y1i = vsubq_f32(x0i, bi);
+            float32x4_t y2r = vaddq_f32(x2r, dr), y2i = vaddq_f32(x2i, di);
+            float32x4_t y3r = vsubq_f32(x2r, dr), y3i = vsubq_f32(x2i, di);
+            float32x4_t cr, ci, er, ei;
+            cmul_neon(y2r, y2i, t2r, t2i, cr, ci);
+            cmul_neon(y3r, y3i, t2r, t2i, er, ei);
+            vst1q_f32(re + i0, vaddq_f32(y0r, cr));
+            vst1q_f32(im + i0, vaddq_f32(y0i, ci));
+            vst1q_f32(re + i2, vsubq_f32(y0r, cr));
+            vst1q_f32(im + i2, vsubq_f32(y0i, ci));
+            vst1q_f32(re + i1, vaddq_f32(y1r, ei));
+            vst1q_f32(im + i1, vsubq_f32(y1i, er));
+            vst1q_f32(re + i3, vsubq_f32(y1r, ei));
+            vst1q_f32(im + i3, vaddq_f32(y1i, er));
+        }
+    }
+}
+
+#endif // SIGNALFLOW_FFT_NEON
+
+class Radix4Plan final : public FFTPlan {
+public:
+    explicit Radix4Plan(size_t nfft, std::pmr::memory_resource* resource = nullptr)
+        : FFTPlan(nfft), m_(nfft / 2), level_(simd::active()),
+          reverse_(AlignedAllocator<uint32_t>(resource)), stages_(AlignedAllocator<Stage>(resource)),
+          twiddles_(AlignedAllocator<float>(resource)), super_r_(AlignedAllocator<float>(resource)),
+          super_i_(AlignedAllocator<float>(resource)) {
+        if (nfft < 2 || !is_power_of_two(nfft)) {
+            throw std::invalid_argument("FFT: Radix4 backend needs a power-of-two size");
+        }
+        // Bit-reversal permutation of the M complex inputs
+        size_t bits = 0;
+        while ((size_t(1) << bits) < m_) ++bits;
+        reverse_.resize(m_);
+        for (size_t k = 0; k < m_; ++k) {
+            uint32_t r = 0;
+            for (size_t b = 0; b < bits; ++b) r |= ((k >> b) & 1u) << (bits - 1 - b);
+            reverse_[k] = r;
+        }
+
+        // Stage plan: the radix-8 first pass covers half-sizes 1, 2 and 4 when M >= 8
+        // (smaller transforms run those stages one by one), then fused pairs while two
+        // stages remain, then a final single stage if needed
+        size_t h = 1;
+        if (m_ >= 8) {
+            h = 8;
+        } else {
+            for (; h < m_; h *= 2) add_stage(h, false);
+        }
+        while (h < m_) {
+            bool fused = 4 * h <= m_;
+            add_stage(h, fused);
+            h *= fused ? 4 : 2;
+        }
+
+        // Twiddles for splitting the complex result into the real spectrum:
+        // exp(-i pi (k / M + 1/2)), k = 1 .. M/2
+        super_r_.resize(m_ / 2);
+        super_i_.resize(m_ / 2);
+        for (size_t i = 0; i < m_ / 2; ++i) {
+            double phase = -std::numbers::pi * ((double) (i + 1) / m_ + .5);
+            super_r_[i] = static_cast<float>(std::cos(phase));
+            super_i_[i] = static_cast<float>(std::sin(phase));
+        }
+    }
+
+    FFTBackend backend() const override { return FFTBackend::Radix4; }
+    size_t scratch_size() const override { return 2 * m_; }
+
+    void forward(const float* in, float* out, float* scratch) const override {
+        float* re = scratch;
+        float* im = scratch + m_;
+        bool avx2 = level_ == simd::Level::AVX2 || level_ == simd::Level::AVX512;
+
+        // 1. Bit-reversed load, z[k] = x[2k] + i x[2k+1], plus the radix-8 pass
+        if (m_ < 8) {
+            for (size_t k = 0; k < m_; ++k) {
+                re[k] = in[2 * reverse_[k]];
+                im[k] = in[2 * reverse_[k] + 1];
+            }
+        } else if (avx2 && m_ >= 64) {
+            first_pass(in, re, im);
+        } else {
+            first_pass_scalar(in, re, im, m_, reverse_.data());
+        }
+
+        // 2. Remaining butterfly stages
+        for (const Stage& stage : stages_) {
+            run_stage(stage, re, im);
+        }
+
+        // 3. Split into the spectrum of the real input
+        out[0] = re[0] + im[0];
+        out[1] = 0.0f;
+        out[2 * m_] = re[0] - im[0];
+        out[2 * m_ + 1] = 0.0f;
+        size_t k = avx2 ? split(re, im, out) : 1;
+        split_scalar(re, im, super_r_.data(), super_i_.data(), out, m_, k);
+    }
+
+private:
+    struct Stage {
+        size_t half;
+        bool fused;
+        size_t twiddle; // Offset into twiddles_: w1r, w1i[, w2r, w2i], each half long
+    };
+
+    void add_stage(size_t h, bool fused) {
+        stages_.push_back({h, fused, twiddles_.size()});
+        size_t base = twiddles_.size();
+        twiddles_.resize(base + (fused ? 4 : 2) * h);
+        for (size_t j = 0; j < h; ++j) {
+            double a1 = -2.0 * std::numbers::pi * j / (2.0 * h);
+            twiddles_[base + j] = static_cast<float>(std::cos(a1));
+            twiddles_[base + h + j] = static_cast<float>(std::sin(a1));
+            if (fused) {
+                double a2 = -2.0 * std::numbers::pi * j / (4.0 * h);
+                twiddles_[base + 2 * h + j] = static_cast<float>(std::cos(a2));
+                twiddles_[base + 3 * h + j] = static_cast<float>(std::sin(a2));
+            }
+        }
+    }
+
+    // The vector kernels need at least one full vector of butterflies per block,
+    // which every stage after the radix-8 pass has
+    void run_stage(const Stage& st, float* re, float* im) const {
+        const float* w = twiddles_.data() + st.twiddle;
+        const size_t h = st.half;
+        if (h >= 8) {
+            switch (level_) {
+#if SIGNALFLOW_FFT_X86
+                case simd::Level::AVX512:
+                case simd::Level::AVX2:
+                    if (st.fused) return radix22_avx2(re, im, m_, h, w, w + h, w + 2 * h, w + 3 * h);
+                    return radix2_avx2(re, im, m_, h, w, w + h);
+#elif SIGNALFLOW_FFT_NEON
+                case simd::Level::NEON:
+                    if (st.fused) return radix22_neon(re, im, m_, h, w, w + h, w + 2 * h, w + 3 * h);
+                    return radix2_neon(re, im, m_, h, w, w + h);
+#endif
+                default:
+                    break;
+            }
+        }
+        if (st.fused) return radix22_scalar(re, im, m_, h, w, w + h, w + 2 * h, w + 3 * h);
+        radix2_scalar(re, im, m_, h, w, w + h);
+    }
+
+    void first_pass(const float* in, float* re, float* im) const {
+#if SIGNALFLOW_FFT_X86
+        first_pass_avx2(in, re, im, m_, reverse_.data());
+#else
+        first_pass_scalar(in, re, im, m_, reverse_.data());
+#endif
+    }
+
+    size_t split(const float* re, const float* im, float* out) const {
+#if SIGNALFLOW_FFT_X86
+        return split_avx2(re, im, super_r_.data(), super_i_.data(), out, m_);
+#else
+        (void) re; (void) im; (void) out;
+        return 1;
+#endif
+    }
+
+    size_t m_;
+    simd::Level level_;
+    AlignedVector<uint32_t> reverse_;
+    AlignedVector<Stage> stages_;
+    AlignedVector<float> twiddles_;
+    AlignedVector<float> super_r_;
+    AlignedVector<float> super_i_;
+};
+
+FFTBackend resolve(size_t nfft, FFTBackend backend) {
+    if (backend != FFTBackend::Auto) return backend;
+    return is_power_of_two(nfft) ? FFTBackend::Radix4 : FFTBackend::Kiss;
+}
+
+}
+
+std::unique_ptr<FFTPlan> make_fft_plan(size_t nfft, FFTBackend backend) {
+    switch (resolve(nfft, backend)) {
+        case FFTBackend::Radix4: return std::make_unique<Radix4Plan>(nfft);
+        default: return std::make_unique<KissPlan>(nfft);
+    }
+}
+
+std::shared_ptr<const FFTPlan> make_fft_plan(size_t nfft, FFTBackend backend, std::pmr::memory_resource* resource) {
+    // allocate_shared puts the control block and the plan in one block from the resource
+    switch (resolve(nfft, backend)) {
+        case FFTBackend::Radix4:
+            return std::allocate_shared<Radix4Plan>(AlignedAllocator<Radix4Plan>(resource), nfft, resource);
+        default:
+            return std::allocate_shared<KissPlan>(AlignedAllocator<KissPlan>(resource), nfft, resource);
+    }
+}
+
+std::shared_ptr<const FFTPlan> fft_plan(size_t nfft, FFTBackend backend) {
+    backend = resolve(nfft, backend);
+    static std::mutex mutex;
+    static std::map<std::pair<size_t, FFTBackend>, std::shared_ptr<const FFTPlan>> cache;
+
+    std::lock_guard lock(mutex);
+    auto& plan = cache[{nfft, backend}];
+    if (!plan) {
+        plan = make_fft_plan(nfft, backend);
+    }
+    return plan;
+}
+
+}
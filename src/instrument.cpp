@@ -0,0 +1,136 @@
+// Registry of per-thread stage histograms and the snapshot that merges them.
+
+#include <signalflow/instrument.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace signalflow::instrument {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<detail::ThreadHistograms>> threads;
+};
+
+// Never destroyed, so threads still exiting during shutdown can release their block
+Registry& registry() {
+    static Registry* instance = new Registry;
+    return *instance;
+}
+
+using clock = std::chrono::steady_clock;
+
+// Start of the TSC calibration window, taken at load time
+const clock::time_point kStartTime = clock::now();
+const uint64_t kStartTicks = detail::now();
+
+// Nanoseconds per timer tick. The TSC rate is measured against steady_clock over the
+// process lifetime so far (at least 10 ms), which also absorbs any startup jitter.
+double ns_per_tick() {
+#if defined(__x86_64__) || defined(__i386__)
+    auto elapsed = clock::now() - kStartTime;
+    while (elapsed < std::chrono::milliseconds(10)) elapsed = clock::now() - kStartTime;
+    uint64_t ticks = detail::now() - kStartTicks;
+    return ticks == 0 ? 1.0 : std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(ticks);
+#else
+    return 1.0;
+#endif
+}
+
+}
+
+const char* name(Stage stage) {
+    switch (stage) {
+        case Stage::Ingest: return "ingest";
+        case Stage::Window: return "window";
+        case Stage::FFT: return "fft";
+        case Stage::FilterBank: return "filterbank";
+        case Stage::PostProcess: return "postprocess";
+        case Stage::Callback: return "callback";
+        default: return "unknown";
+    }
+}
+
+namespace detail {
+
+ThreadHistograms& acquire() {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    for (auto& h : r.threads) {
+        if (!h->in_use.load(std::memory_order_relaxed)) {
+            h->in_use.store(true, std::memory_order_relaxed);
+            return *h;
+        }
+    }
+    r.threads.push_back(std::make_unique<ThreadHistograms>());
+    r.threads.back()->in_use.store(true, std::memory_order_relaxed);
+    return *r.threads.back();
+}
+
+void release(ThreadHistograms& histograms) {
+    // Counts stay in place for snapshot(); the next new thread carries on from them
+    std::lock_guard lock(registry().mutex);
+    histograms.in_use.store(false, std::memory_order_relaxed);
+}
+
+}
+
+Snapshot snapshot() {
+    const double scale = ns_per_tick();
+    Snapshot out;
+    std::vector<uint64_t> merged(detail::kBuckets);
+
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    for (const auto& h : r.threads) out.frames += h->frames.load(std::memory_order_relaxed);
+
+    for (size_t s = 0; s < kStageCount; ++s) {
+        std::fill(merged.begin(), merged.end(), 0);
+        uint64_t total = 0, max = 0;
+        for (const auto& h : r.threads) {
+            for (size_t b = 0; b < detail::kBuckets; ++b) merged[b] += h->buckets[s][b].load(std::memory_order_relaxed);
+            total += h->total[s].load(std::memory_order_relaxed);
+            max = std::max(max, h->max[s].load(std::memory_order_relaxed));
+        }
+        // Count from the buckets themselves so the percentiles are self-consistent
+        uint64_t count = 0;
+        for (uint64_t n : merged) count += n;
+
+        StageStats& stats = out.stages[s];
+        stats.count = count;
+        if (count == 0) continue;
+        auto percentile = [&](double p) {
+            uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(p * static_cast<double>(count) + 0.5));
+            uint64_t seen = 0;
+            for (size_t b = 0; b < detail::kBuckets; ++b) {
+                seen += merged[b];
+                if (seen >= rank) return static_cast<double>(std::min(detail::bucket_upper(b), max)) * scale;
+            }
+            return static_cast<double>(max) * scale;
+        };
+        stats.p50_ns = percentile(0.50);
+        stats.p99_ns = percentile(0.99);
+        stats.max_ns = static_cast<double>(max) * scale;
+        stats.mean_ns = static_cast<double>(total) / static_cast<double>(count) * scale;
+    }
+    return out;
+}
+
+void reset() {
+    Registry& r = registry();
+    std::lock_guard lock(r.mutex);
+    for (auto& h : r.threads) {
+        for (size_t s = 0; s < kStageCount; ++s) {
+            for (auto& bucket : h->buckets[s]) bucket.store(0, std::memory_order_relaxed);
+            h->total[s].store(0, std::memory_order_relaxed);
+            h->max[s].store(0, std::memory_order_relaxed);
+        }
+        h->frames.store(0, std::memory_order_relaxed);
+    }
+}
+
+}
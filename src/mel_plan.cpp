@@ -0,0 +1,275 @@
+// Mel filterbank plans: construction, the blob and header formats, and the process-wide
+// plan cache.
+
+#include <signalflow/mel_plan.hpp>
+#include <signalflow/mel_scale.hpp>
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace signalflow {
+
+namespace {
+
+MelPlanKey checked(const MelPlanKey& key) {
+    if (key.sample_rate <= 0) {
+        throw std::invalid_argument("MelFilterPlan: sample_rate must be positive");
+    }
+    return MelFilterBank::normalize(key);
+}
+
+// --- Blob format (little-endian) -----------------------------------------------------
+//   "SFMP" | u32 version | u32 n_fft | i32 sample_rate | u32 n_mels | f32 f_min | f32 f_max
+//   | u32 n_weights | u32 start_bins[n_mels] | u32 offsets[n_mels + 1] | f32 weights[n_weights]
+//   | u32 checksum (word-wise FNV-1a) of everything before it
+
+constexpr uint32_t kMagic = 0x504d4653; // "SFMP" in little-endian byte order
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderBytes = 32;
+
+// FNV-1a over 32-bit little-endian words (blobs are whole words): a word at a time keeps
+// loading a blob cheaper than building the plan, and any single damaged word is caught
+uint32_t fnv1a(std::span<const uint8_t> bytes) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i + 4 <= bytes.size(); i += 4) {
+        uint32_t word;
+        std::memcpy(&word, bytes.data() + i, 4);
+        if constexpr (std::endian::native == std::endian::big) word = std::byteswap(word);
+        hash = (hash ^ word) * 16777619u;
+    }
+    return hash;
+}
+
+void put_u32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+}
+
+// Sequential reader that throws instead of running off the end
+class Reader {
+public:
+    explicit Reader(std::span<const uint8_t> in) : in_(in) {}
+
+    uint32_t u32() {
+        if (in_.size() - pos_ < 4) throw std::invalid_argument("MelFilterPlan: truncated blob");
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(in_[pos_ + i]) << (8 * i);
+        pos_ += 4;
+        return value;
+    }
+    float f32() { return std::bit_cast<float>(u32()); }
+
+    // n 4-byte values; a straight copy on little-endian hosts
+    template <typename T>
+    void array(T* out, size_t n) {
+        static_assert(sizeof(T) == 4);
+        if (n > (in_.size() - pos_) / 4) throw std::invalid_argument("MelFilterPlan: truncated blob");
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(out, in_.data() + pos_, 4 * n);
+            pos_ += 4 * n;
+        } else {
+            for (size_t i = 0; i < n; ++i) out[i] = std::bit_cast<T>(u32());
+        }
+    }
+
+private:
+    std::span<const uint8_t> in_;
+    size_t pos_ = 0;
+};
+
+std::string decimal(float value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%g", static_cast<double>(value));
+    return text;
+}
+
+// Hex float literal, so the header reproduces every weight bit for bit
+std::string float_literal(float value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%af", static_cast<double>(value));
+    return text;
+}
+
+template <typename T, typename Format>
+void append_array(std::string& out, const char* type, const char* name, std::span<const T> values, Format format) {
+    if (values.empty()) {
+        out += "inline constexpr std::span<const " + std::string(type) + "> " + name + "{};\n\n";
+        return;
+    }
+    out += "inline constexpr " + std::string(type) + " " + name + "[" + std::to_string(values.size()) + "] = {";
+    for (size_t i = 0; i < values.size(); ++i) {
+        out += i % 8 == 0 ? "\n    " : " ";
+        out += format(values[i]);
+        out += ',';
+    }
+    out += "\n};\n\n";
+}
+
+struct PlanCache {
+    std::mutex mutex;
+    std::map<MelPlanKey, std::shared_ptr<const MelFilterPlan>> plans;
+};
+
+PlanCache& plan_cache() {
+    static PlanCache cache;
+    return cache;
+}
+
+}
+
+MelFilterPlan::MelFilterPlan(const MelPlanKey& key, std::pmr::memory_resource* resource)
+    : key_(checked(key)), start_bins_(AlignedAllocator<uint32_t>(resource)),
+      offsets_(AlignedAllocator<uint32_t>(resource)), weights_(AlignedAllocator<float>(resource)) {
+    const size_t n_mels = key_.n_mels;
+
+    // Mel-spaced boundary points as FFT bins; filter m spans bins[m] .. bins[m + 2]
+    AlignedVector<int> bins(n_mels + 2, 0, AlignedAllocator<int>(resource));
+    MelFilterBank::boundary_bins(key_.n_fft, key_.sample_rate, n_mels, key_.f_min, key_.f_max, bins.data());
+
+    start_bins_.resize(n_mels);
+    offsets_.resize(n_mels + 1);
+    offsets_[0] = 0;
+    for (size_t m = 0; m < n_mels; ++m) {
+        auto [first, length] = MelFilterBank::filter_support(bins[m], bins[m + 1], bins[m + 2], n_bins());
+        start_bins_[m] = static_cast<uint32_t>(first);
+        offsets_[m + 1] = offsets_[m] + static_cast<uint32_t>(length);
+    }
+
+    weights_.resize(offsets_[n_mels]);
+    for (size_t m = 0; m < n_mels; ++m) {
+        float* weights = weights_.data() + offsets_[m];
+        int first = static_cast<int>(start_bins_[m]);
+        for (uint32_t j = 0; j < offsets_[m + 1] - offsets_[m]; ++j) {
+            weights[j] = MelFilterBank::filter_weight(first + static_cast<int>(j), bins[m], bins[m + 1], bins[m + 2]);
+        }
+    }
+}
+
+MelFilterPlan::MelFilterPlan(const MelPlanKey& key, std::span<const uint32_t> start_bins,
+                             std::span<const uint32_t> offsets, std::span<const float> weights,
+                             std::pmr::memory_resource* resource)
+    : key_(key), start_bins_(start_bins.begin(), start_bins.end(), AlignedAllocator<uint32_t>(resource)),
+      offsets_(offsets.begin(), offsets.end(), AlignedAllocator<uint32_t>(resource)),
+      weights_(weights.begin(), weights.end(), AlignedAllocator<float>(resource)) {
+    validate();
+}
+
+void MelFilterPlan::validate() const {
+    if (key_.sample_rate <= 0 || !(MelFilterBank::normalize(key_) == key_)) {
+        throw std::invalid_argument("MelFilterPlan: key is not normalized");
+    }
+    const size_t n_mels = key_.n_mels;
+    if (start_bins_.size() != n_mels || offsets_.size() != n_mels + 1 || offsets_[0] != 0 ||
+        offsets_[n_mels] != weights_.size()) {
+        throw std::invalid_argument("MelFilterPlan: table sizes do not match the key");
+    }
+    for (size_t m = 0; m < n_mels; ++m) {
+        if (offsets_[m + 1] < offsets_[m] || start_bins_[m] > n_bins() ||
+            offsets_[m + 1] - offsets_[m] > n_bins() - start_bins_[m]) {
+            throw std::invalid_argument("MelFilterPlan: filter outside the spectrum");
+        }
+    }
+}
+
+std::vector<uint8_t> MelFilterPlan::serialize() const {
+    std::vector<uint8_t> out;
+    out.reserve(kHeaderBytes + 4 * (start_bins_.size() + offsets_.size() + weights_.size() + 1));
+    put_u32(out, kMagic);
+    put_u32(out, kVersion);
+    put_u32(out, static_cast<uint32_t>(key_.n_fft));
+    put_u32(out, static_cast<uint32_t>(key_.sample_rate));
+    put_u32(out, static_cast<uint32_t>(key_.n_mels));
+    put_u32(out, std::bit_cast<uint32_t>(key_.f_min));
+    put_u32(out, std::bit_cast<uint32_t>(key_.f_max));
+    put_u32(out, static_cast<uint32_t>(weights_.size()));
+    for (uint32_t v : start_bins_) put_u32(out, v);
+    for (uint32_t v : offsets_) put_u32(out, v);
+    for (float w : weights_) put_u32(out, std::bit_cast<uint32_t>(w));
+    put_u32(out, fnv1a(out));
+    return out;
+}
+
+std::shared_ptr<const MelFilterPlan> MelFilterPlan::deserialize(std::span<const uint8_t> blob) {
+    Reader in(blob);
+    if (blob.size() < 4 || in.u32() != kMagic) throw std::invalid_argument("MelFilterPlan: not a filterbank blob");
+    if (in.u32() != kVersion) throw std::invalid_argument("MelFilterPlan: unsupported blob version");
+
+    MelPlanKey key;
+    key.n_fft = in.u32();
+    key.sample_rate = static_cast<int32_t>(in.u32());
+    key.n_mels = in.u32();
+    key.f_min = in.f32();
+    key.f_max = in.f32();
+    const size_t n_weights = in.u32();
+
+    // Check the size before allocating anything it implies
+    const uint64_t expected = kHeaderBytes + 4 * (uint64_t(key.n_mels) * 2 + 1 + n_weights + 1);
+    if (blob.size() != expected) throw std::invalid_argument("MelFilterPlan: blob size does not match its header");
+    if (fnv1a(blob.first(blob.size() - 4)) != Reader(blob.last(4)).u32()) {
+        throw std::invalid_argument("MelFilterPlan: blob checksum mismatch");
+    }
+
+    std::vector<uint32_t> start_bins(key.n_mels), offsets(key.n_mels + 1);
+    std::vector<float> weights(n_weights);
+    in.array(start_bins.data(), start_bins.size());
+    in.array(offsets.data(), offsets.size());
+    in.array(weights.data(), weights.size());
+    return std::make_shared<const MelFilterPlan>(key, start_bins, offsets, weights);
+}
+
+std::string MelFilterPlan::header(std::string_view name) const {
+    std::string out;
+    out += "// Mel filterbank plan generated by signalflow::MelFilterPlan::header(); do not edit.\n";
+    out += "// n_fft " + std::to_string(key_.n_fft) + ", sample_rate " + std::to_string(key_.sample_rate) +
+           ", n_mels " + std::to_string(key_.n_mels) + ", f_min " + decimal(key_.f_min) +
+           " Hz, f_max " + decimal(key_.f_max) + " Hz\n";
+    out += "#pragma once\n#include <cstdint>\n#include <memory>\n#include <span>\n#include <signalflow/mel_plan.hpp>\n\n";
+    out += "namespace " + std::string(name) + " {\n\n";
+    out += "inline constexpr signalflow::MelPlanKey kKey{" + std::to_string(key_.n_fft) + ", " +
+           std::to_string(key_.sample_rate) + ", " + std::to_string(key_.n_mels) + ", " +
+           float_literal(key_.f_min) + ", " + float_literal(key_.f_max) + "};\n\n";
+    auto integer = [](uint32_t v) { return std::to_string(v); };
+    append_array(out, "uint32_t", "kStartBins", start_bins(), integer);
+    append_array(out, "uint32_t", "kOffsets", offsets(), integer);
+    append_array(out, "float", "kWeights", weights(), float_literal);
+    out += "// Seeds the process-wide plan cache, so filterbanks with these parameters skip the mel math\n";
+    out += "inline void register_plan() {\n";
+    out += "    signalflow::register_mel_filter_plan(std::make_shared<const signalflow::MelFilterPlan>(\n";
+    out += "        kKey, std::span<const uint32_t>(kStartBins), std::span<const uint32_t>(kOffsets),\n";
+    out += "        std::span<const float>(kWeights)));\n";
+    out += "}\n\n}\n";
+    return out;
+}
+
+std::shared_ptr<const MelFilterPlan> make_mel_filter_plan(const MelPlanKey& key, std::pmr::memory_resource* resource) {
+    if (resource) {
+        return std::allocate_shared<MelFilterPlan>(AlignedAllocator<MelFilterPlan>(resource), key, resource);
+    }
+    return std::make_shared<const MelFilterPlan>(key);
+}
+
+std::shared_ptr<const MelFilterPlan> mel_filter_plan(const MelPlanKey& key) {
+    MelPlanKey normalized = checked(key);
+    PlanCache& cache = plan_cache();
+
+    std::lock_guard lock(cache.mutex);
+    auto& plan = cache.plans[normalized];
+    if (!plan) {
+        plan = make_mel_filter_plan(normalized);
+    }
+    return plan;
+}
+
+void register_mel_filter_plan(std::shared_ptr<const MelFilterPlan> plan) {
+    if (!plan) throw std::invalid_argument("register_mel_filter_plan: null plan");
+    PlanCache& cache = plan_cache();
+
+    std::lock_guard lock(cache.mutex);
+    cache.plans.insert_or_assign(plan->key(), std::move(plan));
+}
+
+}
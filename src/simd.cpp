@@ -0,0 +1,503 @@
+// SIMD kernels for the per-frame hot path, with runtime CPU dispatch.
+// x86 paths are compiled with per-function target attributes, so the library
+// itself needs no special -m flags and still runs on CPUs without AVX.
+
+#include <signalflow/simd.hpp>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIGNALFLOW_SIMD_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define SIGNALFLOW_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace signalflow::simd {
+
+namespace {
+
+// Scalar reference kernels; the vector paths use these for their tails
+void magnitude_scalar(const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        float re = in[2 * i];
+        float im = in[2 * i + 1];
+        out[i] = std::sqrt(re * re + im * im);
+    }
+}
+
+void power_scalar(const float* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        float re = in[2 * i];
+        float im = in[2 * i + 1];
+        out[i] = re * re + im * im;
+    }
+}
+
+float dot_scalar(const float* a, const float* b, size_t n) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+constexpr float kPcm16Scale = 0.000030517578125f; // 1/32768, matches drwav_s16_to_f32
+
+void pcm16_to_mono_scalar(const int16_t* in, size_t channels, float* out, size_t frames) {
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (size_t ch = 0; ch < channels; ++ch) {
+            sum += in[i * channels + ch] * kPcm16Scale;
+        }
+        out[i] = sum / channels;
+    }
+}
+
+// Natural log after clamping to [lo, FLT_MAX]: Cephes logf without its special-case
+// branches. x = 2^e * m with m in [sqrt(1/2), sqrt(2)), ln(m) is a degree-9 polynomial
+// in m - 1, and e * ln2 is added in two parts (0.693359375 is exact in float). The
+// exponent and mantissa come straight from the bits, so lo must be a normal float.
+// Max error vs the exact log, measured over every positive normal float: 4.6e-8
+// absolute where |ln x| <= 1, and 0.71 ulp (8.1e-8 relative) elsewhere.
+// The vector paths compute exactly this sequence (mul and add, no FMA) lane by lane.
+constexpr float kSqrtHalf = 0.707106781186547524f;
+constexpr float kLogP[9] = {7.0376836292e-2f, -1.1514610310e-1f, 1.1676998740e-1f,
+                            -1.2420140846e-1f, 1.4249322787e-1f, -1.6668057665e-1f,
+                            2.0000714765e-1f, -2.4999993993e-1f, 3.3333331174e-1f};
+constexpr float kLn2Hi = 0.693359375f;
+constexpr float kLn2Lo = -2.12194440e-4f;
+
+float log_clamped(float x, float lo) {
+    x = x > lo ? x : lo; // NaN takes the floor
+    x = x < FLT_MAX ? x : FLT_MAX;
+    uint32_t bits = std::bit_cast<uint32_t>(x);
+    float e = static_cast<float>(static_cast<int32_t>(bits >> 23) - 126);
+    float m = std::bit_cast<float>((bits & 0x007fffffu) | 0x3f000000u); // [0.5, 1)
+    if (m < kSqrtHalf) {
+        e = e - 1.0f;
+        m = m + m;
+    }
+    m = m - 1.0f;
+    float z = m * m;
+    float y = kLogP[0];
+    for (int i = 1; i < 9; ++i) y = y * m + kLogP[i];
+    y = y * m * z;
+    y = y + kLn2Lo * e;
+    y = y - 0.5f * z;
+    return (m + y) + kLn2Hi * e;
+}
+
+void log_floor_scalar(const float* in, float* out, size_t n, float floor, float scale) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = scale * log_clamped(in[i], floor);
+    }
+}
+
+#if SIGNALFLOW_SIMD_X86
+
+// Sums squared (re, im) pairs of 8 complex values held in two registers, in order
+__attribute__((target("avx2,fma")))
+inline __m256 power8_avx2(const float* in) {
+    __m256 a = _mm256_loadu_ps(in);     // complex 0..3
+    __m256 b = _mm256_loadu_ps(in + 8); // complex 4..7
+    // hadd yields [p0 p1 p4 p5 | p2 p3 p6 p7]; reorder the 64-bit pairs
+    __m256 sums = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), 0xD8));
+}
+
+__attribute__((target("avx2,fma")))
+void magnitude_avx2(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_sqrt_ps(power8_avx2(in + 2 * i)));
+    }
+    magnitude_scalar(in + 2 * i, out + i, n - i);
+}
+
+__attribute__((target("avx2,fma")))
+void power_avx2(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, power8_avx2(in + 2 * i));
+    }
+    power_scalar(in + 2 * i, out + i, n - i);
+}
+
+// Dot products of R rows against shared weights. Each row sees exactly the operation
+// sequence of a single-row call, so dot_rows() results are bit-identical to dot().
+template <int R>
+__attribute__((target("avx2,fma")))
+inline void dot_rows_avx2(const float* const* a, const float* b, size_t n, float* out) {
+    __m256 acc0[R], acc1[R];
+    for (int r = 0; r < R; ++r) acc0[r] = acc1[r] = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 w0 = _mm256_loadu_ps(b + i);
+        __m256 w1 = _mm256_loadu_ps(b + i + 8);
+        for (int r = 0; r < R; ++r) {
+            acc0[r] = _mm256_fmadd_ps(_mm256_loadu_ps(a[r] + i), w0, acc0[r]);
+            acc1[r] = _mm256_fmadd_ps(_mm256_loadu_ps(a[r] + i + 8), w1, acc1[r]);
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 w0 = _mm256_loadu_ps(b + i);
+        for (int r = 0; r < R; ++r) acc0[r] = _mm256_fmadd_ps(_mm256_loadu_ps(a[r] + i), w0, acc0[r]);
+    }
+    for (int r = 0; r < R; ++r) {
+        __m256 acc = _mm256_add_ps(acc0[r], acc1[r]);
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_movehdup_ps(half));
+        out[r] = _mm_cvtss_f32(half) + dot_scalar(a[r] + i, b + i, n - i);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void pcm16_to_mono_avx2(const int16_t* in, size_t channels, float* out, size_t frames) {
+    const __m256 scale = _mm256_set1_ps(kPcm16Scale);
+    size_t i = 0;
+    if (channels == 1) {
+        for (; i + 8 <= frames; i += 8) {
+            __m256i wide = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(wide), scale));
+        }
+    } else if (channels == 2) {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        for (; i + 8 <= frames; i += 8) {
+            // 8 stereo frames: L0 R0 .. L3 R3 | L4 R4 .. L7 R7
+            __m256i pcm = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * i));
+            __m256 a = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(pcm))), scale);
+            __m256 b = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(pcm, 1))), scale);
+            // hadd yields [f0 f1 f4 f5 | f2 f3 f6 f7]; reorder the 64-bit pairs
+            __m256 sums = _mm256_hadd_ps(a, b);
+            sums = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), 0xD8));
+            _mm256_storeu_ps(out + i, _mm256_mul_ps(sums, half));
+        }
+    }
+    pcm16_to_mono_scalar(in + i * channels, channels, out + i, frames - i);
+}
+
+// GCC 12's AVX-512 intrinsics trip -Wuninitialized on their internal _mm512_undefined_* placeholders
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+// Splits 16 interleaved complex values into real and imaginary registers
+__attribute__((target("avx512f")))
+inline __m512 power16_avx512(const float* in) {
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    __m512 a = _mm512_loadu_ps(in);
+    __m512 b = _mm512_loadu_ps(in + 16);
+    __m512 re = _mm512_permutex2var_ps(a, even, b);
+    __m512 im = _mm512_permutex2var_ps(a, odd, b);
+    return _mm512_add_ps(_mm512_mul_ps(re, re), _mm512_mul_ps(im, im));
+}
+
+__attribute__((target("avx512f")))
+void magnitude_avx512(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, _mm512_sqrt_ps(power16_avx512(in + 2 * i)));
+    }
+    magnitude_scalar(in + 2 * i, out + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+void power_avx512(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(out + i, power16_avx512(in + 2 * i));
+    }
+    power_scalar(in + 2 * i, out + i, n - i);
+}
+
+template <int R>
+__attribute__((target("avx512f")))
+inline void dot_rows_avx512(const float* const* a, const float* b, size_t n, float* out) {
+    __m512 acc[R];
+    for (int r = 0; r < R; ++r) acc[r] = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 w = _mm512_loadu_ps(b + i);
+        for (int r = 0; r < R; ++r) acc[r] = _mm512_fmadd_ps(_mm512_loadu_ps(a[r] + i), w, acc[r]);
+    }
+    // Masked load handles the tail without a scalar loop
+    if (i < n) {
+        __mmask16 mask = static_cast<__mmask16>((1u << (n - i)) - 1);
+        __m512 w = _mm512_maskz_loadu_ps(mask, b + i);
+        for (int r = 0; r < R; ++r) acc[r] = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a[r] + i), w, acc[r]);
+    }
+    for (int r = 0; r < R; ++r) out[r] = _mm512_reduce_add_ps(acc[r]);
+}
+
+#pragma GCC diagnostic pop
+
+// Eight lanes of log_clamped. Deliberately avx2 without fma, so that mul + add pairs
+// are never contracted and the lanes match the scalar tail bit for bit.
+__attribute__((target("avx2")))
+void log_floor_avx2(const float* in, float* out, size_t n, float floor, float scale) {
+    const __m256 lo = _mm256_set1_ps(floor), hi = _mm256_set1_ps(FLT_MAX);
+    const __m256 one = _mm256_set1_ps(1.0f), sqrt_half = _mm256_set1_ps(kSqrtHalf);
+    const __m256i mantissa = _mm256_set1_epi32(0x007fffff), half = _mm256_set1_epi32(0x3f000000);
+    const __m256i bias = _mm256_set1_epi32(126);
+    const __m256 k = _mm256_set1_ps(scale);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // max/min return the second operand for NaN, like the scalar compares
+        __m256 x = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(in + i), lo), hi);
+        __m256i bits = _mm256_castps_si256(x);
+        __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias));
+        __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissa), half));
+        __m256 small = _mm256_cmp_ps(m, sqrt_half, _CMP_LT_OQ);
+        e = _mm256_sub_ps(e, _mm256_and_ps(small, one));
+        m = _mm256_sub_ps(_mm256_add_ps(m, _mm256_and_ps(small, m)), one);
+        __m256 z = _mm256_mul_ps(m, m);
+        __m256 y = _mm256_set1_ps(kLogP[0]);
+        for (int j = 1; j < 9; ++j) y = _mm256_add_ps(_mm256_mul_ps(y, m), _mm256_set1_ps(kLogP[j]));
+        y = _mm256_mul_ps(_mm256_mul_ps(y, m), z);
+        y = _mm256_add_ps(y, _mm256_mul_ps(_mm256_set1_ps(kLn2Lo), e));
+        y = _mm256_sub_ps(y, _mm256_mul_ps(_mm256_set1_ps(0.5f), z));
+        __m256 r = _mm256_add_ps(_mm256_add_ps(m, y), _mm256_mul_ps(_mm256_set1_ps(kLn2Hi), e));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(k, r));
+    }
+    log_floor_scalar(in + i, out + i, n - i, floor, scale);
+}
+
+#endif // SIGNALFLOW_SIMD_X86
+
+#if SIGNALFLOW_SIMD_NEON
+
+void magnitude_neon(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t v = vld2q_f32(in + 2 * i); // deinterleaves re / im
+        float32x4_t p = vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1]));
+        vst1q_f32(out + i, vsqrtq_f32(p));
+    }
+    magnitude_scalar(in + 2 * i, out + i, n - i);
+}
+
+void power_neon(const float* in, float* out, size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4x2_t v = vld2q_f32(in + 2 * i);
+        vst1q_f32(out + i, vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1])));
+    }
+    power_scalar(in + 2 * i, out + i, n - i);
+}
+
+template <int R>
+void dot_rows_neon(const float* const* a, const float* b, size_t n, float* out) {
+    float32x4_t acc[R];
+    for (int r = 0; r < R; ++r) acc[r] = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t w = vld1q_f32(b + i);
+        for (int r = 0; r < R; ++r) acc[r] = vfmaq_f32(acc[r], vld1q_f32(a[r] + i), w);
+    }
+    for (int r = 0; r < R; ++r) out[r] = vaddvq_f32(acc[r]) + dot_scalar(a[r] + i, b + i, n - i);
+}
+
+void pcm16_to_mono_neon(const int16_t* in, size_t channels, float* out, size_t frames) {
+    const float32x4_t scale = vdupq_n_f32(kPcm16Scale);
+    size_t i = 0;
+    if (channels == 1) {
+        for (; i + 8 <= frames; i += 8) {
+            int16x8_t pcm = vld1q_s16(in + i);
+            vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(pcm))), scale));
+            vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(pcm))), scale));
+        }
+    } else if (channels == 2) {
+        for (; i + 8 <= frames; i += 8) {
+            int16x8x2_t pcm = vld2q_s16(in + 2 * i); // deinterleaves L / R
+            for (int h = 0; h < 2; ++h) {
+                int16x4_t l = h ? vget_high_s16(pcm.val[0]) : vget_low_s16(pcm.val[0]);
+                int16x4_t r = h ? vget_high_s16(pcm.val[1]) : vget_low_s16(pcm.val[1]);
+                float32x4_t sum = vaddq_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(l)), scale),
+                                            vmulq_f32(vcvtq_f32_s32(vmovl_s16(r)), scale));
+                vst1q_f32(out + i + 4 * h, vmulq_n_f32(sum, 0.5f));
+            }
+        }
+    }
+    pcm16_to_mono_scalar(in + i * channels, channels, out + i, frames - i);
+}
+
+void log_floor_neon(const float* in, float* out, size_t n, float floor, float scale) {
+    const float32x4_t lo = vdupq_n_f32(floor), hi = vdupq_n_f32(FLT_MAX);
+    const float32x4_t one = vdupq_n_f32(1.0f), sqrt_half = vdupq_n_f32(kSqrtHalf);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // vmaxnm/vminnm return the number when one operand is NaN
+        float32x4_t x = vminnmq_f32(vmaxnmq_f32(vld1q_f32(in + i), lo), hi);
+        uint32x4_t bits = vreinterpretq_u32_f32(x);
+        float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(126)));
+        float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f000000)));
+        uint32x4_t small = vcltq_f32(m, sqrt_half);
+        e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(one))));
+        m = vsubq_f32(vaddq_f32(m, vreinterpretq_f32_u32(vandq_u32(small, vreinterpretq_u32_f32(m)))), one);
+        float32x4_t z = vmulq_f32(m, m);
+        float32x4_t y = vdupq_n_f32(kLogP[0]);
+        for (int j = 1; j < 9; ++j) y = vaddq_f32(vmulq_f32(y, m), vdupq_n_f32(kLogP[j]));
+        y = vmulq_f32(vmulq_f32(y, m), z);
+        y = vaddq_f32(y, vmulq_n_f32(e, kLn2Lo));
+        y = vsubq_f32(y, vmulq_n_f32(z, 0.5f));
+        float32x4_t r = vaddq_f32(vaddq_f32(m, y), vmulq_n_f32(e, kLn2Hi));
+        vst1q_f32(out + i, vmulq_n_f32(r, scale));
+    }
+    log_floor_scalar(in + i, out + i, n - i, floor, scale);
+}
+
+#endif // SIGNALFLOW_SIMD_NEON
+
+// Runs a rows kernel over count rows, four at a time with a single-row remainder
+template <void (*Rows4)(const float* const*, const float*, size_t, float*),
+          void (*Rows1)(const float* const*, const float*, size_t, float*)>
+void dot_rows_blocked(const float* rows, size_t row_stride, size_t count,
+                      const float* weights, size_t n, float* out, size_t out_stride) {
+    size_t r = 0;
+    for (; r + 4 <= count; r += 4) {
+        const float* a[4] = {rows + r * row_stride, rows + (r + 1) * row_stride,
+                             rows + (r + 2) * row_stride, rows + (r + 3) * row_stride};
+        float results[4];
+        Rows4(a, weights, n, results);
+        for (size_t k = 0; k < 4; ++k) out[(r + k) * out_stride] = results[k];
+    }
+    for (; r < count; ++r) {
+        const float* a[1] = {rows + r * row_stride};
+        Rows1(a, weights, n, out + r * out_stride);
+    }
+}
+
+Level detect() {
+#if SIGNALFLOW_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Level::AVX2;
+#elif SIGNALFLOW_SIMD_NEON
+    return Level::NEON; // Always present on AArch64
+#endif
+    return Level::Scalar;
+}
+
+}
+
+Level active() {
+    static const Level level = detect();
+    return level;
+}
+
+bool supported(Level level) {
+    switch (level) {
+        case Level::Scalar: return true;
+        case Level::NEON: return active() == Level::NEON;
+        case Level::AVX2: return active() == Level::AVX2 || active() == Level::AVX512;
+        case Level::AVX512: return active() == Level::AVX512;
+    }
+    return false;
+}
+
+namespace {
+
+// Levels this CPU cannot run are replaced by the best one it can, so asking for AVX-512
+// on an AVX2-only machine never reaches a kernel built for instructions it lacks
+Level usable(Level level) {
+    return supported(level) ? level : active();
+}
+
+}
+
+const char* name(Level level) {
+    switch (level) {
+        case Level::Scalar: return "scalar";
+        case Level::NEON: return "neon";
+        case Level::AVX2: return "avx2";
+        case Level::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+void magnitude(const float* interleaved, float* out, size_t n, Level level) {
+    switch (usable(level)) {
+#if SIGNALFLOW_SIMD_X86
+        case Level::AVX512: return magnitude_avx512(interleaved, out, n);
+        case Level::AVX2: return magnitude_avx2(interleaved, out, n);
+#elif SIGNALFLOW_SIMD_NEON
+        case Level::NEON: return magnitude_neon(interleaved, out, n);
+#endif
+        default: return magnitude_scalar(interleaved, out, n);
+    }
+}
+
+void power(const float* interleaved, float* out, size_t n, Level level) {
+    switch (usable(level)) {
+#if SIGNALFLOW_SIMD_X86
+        case Level::AVX512: return power_avx512(interleaved, out, n);
+        case Level::AVX2: return power_avx2(interleaved, out, n);
+#elif SIGNALFLOW_SIMD_NEON
+        case Level::NEON: return power_neon(interleaved, out, n);
+#endif
+        default: return power_scalar(interleaved, out, n);
+    }
+}
+
+float dot(const float* a, const float* b, size_t n, Level level) {
+    float result;
+    switch (usable(level)) {
+#if SIGNALFLOW_SIMD_X86
+        case Level::AVX512: dot_rows_avx512<1>(&a, b, n, &result); return result;
+        case Level::AVX2: dot_rows_avx2<1>(&a, b, n, &result); return result;
+#elif SIGNALFLOW_SIMD_NEON
+        case Level::NEON: dot_rows_neon<1>(&a, b, n, &result); return result;
+#endif
+        default: return dot_scalar(a, b, n);
+    }
+}
+
+void dot_rows(const float* rows, size_t row_stride, size_t count,
+              const float* weights, size_t n, float* out, size_t out_stride, Level level) {
+    switch (usable(level)) {
+#if SIGNALFLOW_SIMD_X86
+        case Level::AVX512:
+            return dot_rows_blocked<dot_rows_avx512<4>, dot_rows_avx512<1>>(rows, row_stride, count, weights, n, out, out_stride);
+        case Level::AVX2:
+            return dot_rows_blocked<dot_rows_avx2<4>, dot_rows_avx2<1>>(rows, row_stride, count, weights, n, out, out_stride);
+#elif SIGNALFLOW_SIMD_NEON
+        case Level::NEON:
+            return dot_rows_blocked<dot_rows_neon<4>, dot_rows_neon<1>>(rows, row_stride, count, weights, n, out, out_stride);
+#endif
+        default:
+            for (size_t r = 0; r < count; ++r) {
+                out[r * out_stride] = dot_scalar(rows + r * row_stride, weights, n);
+            }
+    }
+}
+
+void pcm16_to_mono(const int16_t* in, size_t channels, float* out, size_t frames, Level level) {
+    switch (usable(level)) {
+#if SIGNALFLOW_SIMD_X86
+        case Level::AVX512:
+        case Level::AVX2: return pcm16_to_mono_avx2(in, channels, out, frames);
+#elif SIGNALFLOW_SIMD_NEON
+        case Level::NEON: return pcm16_to_mono_neon(in, channels, out, frames);
+#endif
+        default: return pcm16_to_mono_scalar(in, channels, out, frames);
+    }
+}
+
+void log_floor(const float* in, float* out, size_t n, float floor, float scale, Level level) {
+    switch (usable(level)) {
+#if SIGNALFLOW_SIMD_X86
+        case Level::AVX512:
+        case Level::AVX2: return log_floor_avx2(in, out, n, floor, scale);
+#elif SIGNALFLOW_SIMD_NEON
+        case Level::NEON: return log_floor_neon(in, out, n, floor, scale);
+#endif
+        default: return log_floor_scalar(in, out, n, floor, scale);
+    }
+}
+
+}
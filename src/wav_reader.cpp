@@ -0,0 +1,121 @@
+// Memory-mapped WAV reader (POSIX mmap)
+
+#include <signalflow/wav_reader.hpp>
+#include <signalflow/simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace signalflow {
+
+WavReader::WavReader(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("WavReader: cannot open " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("WavReader: cannot stat or empty file " + path);
+    }
+    mapping_size_ = static_cast<size_t>(st.st_size);
+    void* mapping = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file referenced
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("WavReader: cannot map " + path);
+    }
+    mapping_ = static_cast<const unsigned char*>(mapping);
+    ::madvise(mapping, mapping_size_, MADV_SEQUENTIAL);
+
+    if (!drwav_init_memory(&wav_, mapping_, mapping_size_, nullptr)) {
+        close();
+        throw std::runtime_error("WavReader: not a valid WAV file " + path);
+    }
+    wav_open_ = true;
+    total_frames_ = wav_.totalPCMFrameCount;
+
+    // Little-endian PCM16 / float32 is read from the mapping directly; the data chunk
+    // is clamped to the bytes that are actually present
+    bool little_endian = std::endian::native == std::endian::little &&
+        (wav_.container == drwav_container_riff || wav_.container == drwav_container_rf64 ||
+         wav_.container == drwav_container_w64);
+    samples_ = mapping_ + wav_.dataChunkDataPos;
+    size_t bytes_available = wav_.dataChunkDataPos < mapping_size_ ? mapping_size_ - wav_.dataChunkDataPos : 0;
+    if (little_endian && wav_.translatedFormatTag == DR_WAVE_FORMAT_PCM && wav_.bitsPerSample == 16 &&
+        reinterpret_cast<uintptr_t>(samples_) % alignof(int16_t) == 0) {
+        source_ = Source::Pcm16;
+        total_frames_ = std::min<uint64_t>(total_frames_, bytes_available / (2 * wav_.channels));
+    } else if (little_endian && wav_.translatedFormatTag == DR_WAVE_FORMAT_IEEE_FLOAT && wav_.bitsPerSample == 32) {
+        source_ = Source::Float32;
+        total_frames_ = std::min<uint64_t>(total_frames_, bytes_available / (4 * wav_.channels));
+    }
+}
+
+WavReader::~WavReader() {
+    close();
+}
+
+void WavReader::close() {
+    if (wav_open_) {
+        drwav_uninit(&wav_);
+        wav_open_ = false;
+    }
+    if (mapping_) {
+        ::munmap(const_cast<unsigned char*>(mapping_), mapping_size_);
+        mapping_ = nullptr;
+    }
+}
+
+size_t WavReader::read(std::span<float> out) {
+    const size_t channels = wav_.channels;
+    size_t frames = static_cast<size_t>(std::min<uint64_t>(out.size(), total_frames_ - position_));
+    if (frames == 0) return 0;
+
+    switch (source_) {
+        case Source::Pcm16: {
+            const auto* pcm = reinterpret_cast<const int16_t*>(samples_) + position_ * channels;
+            simd::pcm16_to_mono(pcm, channels, out.data(), frames);
+            break;
+        }
+        case Source::Float32: {
+            const unsigned char* bytes = samples_ + position_ * channels * sizeof(float);
+            if (channels == 1) {
+                std::memcpy(out.data(), bytes, frames * sizeof(float));
+                break;
+            }
+            for (size_t i = 0; i < frames; ++i) {
+                float sum = 0.0f;
+                for (size_t ch = 0; ch < channels; ++ch) {
+                    float sample;
+                    std::memcpy(&sample, bytes + (i * channels + ch) * sizeof(float), sizeof(float));
+                    sum += sample;
+                }
+                out[i] = sum / channels;
+            }
+            break;
+        }
+        case Source::Decode: {
+            scratch_.resize(std::max(scratch_.size(), frames * channels));
+            frames = static_cast<size_t>(drwav_read_pcm_frames_f32(&wav_, frames, scratch_.data()));
+            for (size_t i = 0; i < frames; ++i) {
+                float sum = 0.0f;
+                for (size_t ch = 0; ch < channels; ++ch) {
+                    sum += scratch_[i * channels + ch];
+                }
+                out[i] = sum / channels;
+            }
+            break;
+        }
+    }
+    position_ += frames;
+    return frames;
+}
+
+}
@@ -0,0 +1,97 @@
+// Mel filterbank plan generated by signalflow::MelFilterPlan::header(); do not edit.
+// n_fft 512, sample_rate 16000, n_mels 40, f_min 0 Hz, f_max 8000 Hz
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <signalflow/mel_plan.hpp>
+
+namespace mel_512_40 {
+
+inline constexpr signalflow::MelPlanKey kKey{512, 16000, 40, 0x0p+0f, 0x1.f4p+12f};
+
+inline constexpr uint32_t kStartBins[40] = {
+    1, 2, 3, 5, 7, 9, 11, 13,
+    15, 17, 20, 22, 25, 28, 31, 34,
+    38, 42, 46, 50, 55, 60, 65, 70,
+    76, 82, 89, 96, 104, 111, 120, 129,
+    138, 149, 159, 171, 183, 196, 210, 225,
+};
+
+inline constexpr uint32_t kOffsets[41] = {
+    0, 1, 3, 6, 9, 12, 15, 18,
+    21, 25, 29, 33, 38, 43, 48, 54,
+    61, 68, 75, 83, 92, 101, 110, 120,
+    131, 143, 156, 170, 184, 199, 216, 233,
+    252, 272, 293, 316, 340, 366, 394, 423,
+    454,
+};
+
+inline constexpr float kWeights[454] = {
+    0x1p+0f, 0x1p+0f, 0x1p-1f, 0x1p-1f, 0x1p+0f, 0x1p-1f, 0x1p-1f, 0x1p+0f,
+    0x1p-1f, 0x1p-1f, 0x1p+0f, 0x1p-1f, 0x1p-1f, 0x1p+0f, 0x1p-1f, 0x1p-1f,
+    0x1p+0f, 0x1p-1f, 0x1p-1f, 0x1p+0f, 0x1p-1f, 0x1p-1f, 0x1p+0f, 0x1.555556p-1f,
+    0x1.555556p-2f, 0x1.555556p-2f, 0x1.555556p-1f, 0x1p+0f, 0x1p-1f, 0x1p-1f, 0x1p+0f, 0x1.555556p-1f,
+    0x1.555556p-2f, 0x1.555556p-2f, 0x1.555556p-1f, 0x1p+0f, 0x1.555556p-1f, 0x1.555556p-2f, 0x1.555556p-2f, 0x1.555556p-1f,
+    0x1p+0f, 0x1.555556p-1f, 0x1.555556p-2f, 0x1.555556p-2f, 0x1.555556p-1f, 0x1p+0f, 0x1.555556p-1f, 0x1.555556p-2f,
+    0x1.555556p-2f, 0x1.555556p-1f, 0x1p+0f, 0x1.8p-1f, 0x1p-1f, 0x1p-2f, 0x1p-2f, 0x1p-1f,
+    0x1.8p-1f, 0x1p+0f, 0x1.8p-1f, 0x1p-1f, 0x1p-2f, 0x1p-2f, 0x1p-1f, 0x1.8p-1f,
+    0x1p+0f, 0x1.8p-1f, 0x1p-1f, 0x1p-2f, 0x1p-2f, 0x1p-1f, 0x1.8p-1f, 0x1p+0f,
+    0x1.8p-1f, 0x1p-1f, 0x1p-2f, 0x1p-2f, 0x1p-1f, 0x1.8p-1f, 0x1p+0f, 0x1.99999ap-1f,
+    0x1.333334p-1f, 0x1.99999ap-2f, 0x1.99999ap-3f, 0x1.99999ap-3f, 0x1.99999ap-2f, 0x1.333334p-1f, 0x1.99999ap-1f, 0x1p+0f,
+    0x1.99999ap-1f, 0x1.333334p-1f, 0x1.99999ap-2f, 0x1.99999ap-3f, 0x1.99999ap-3f, 0x1.99999ap-2f, 0x1.333334p-1f, 0x1.99999ap-1f,
+    0x1p+0f, 0x1.99999ap-1f, 0x1.333334p-1f, 0x1.99999ap-2f, 0x1.99999ap-3f, 0x1.99999ap-3f, 0x1.99999ap-2f, 0x1.333334p-1f,
+    0x1.99999ap-1f, 0x1p+0f, 0x1.99999ap-1f, 0x1.333334p-1f, 0x1.99999ap-2f, 0x1.99999ap-3f, 0x1.99999ap-3f, 0x1.99999ap-2f,
+    0x1.333334p-1f, 0x1.99999ap-1f, 0x1p+0f, 0x1.aaaaaap-1f, 0x1.555556p-1f, 0x1p-1f, 0x1.555556p-2f, 0x1.555556p-3f,
+    0x1.555556p-3f, 0x1.555556p-2f, 0x1p-1f, 0x1.555556p-1f, 0x1.aaaaaap-1f, 0x1p+0f, 0x1.aaaaaap-1f, 0x1.555556p-1f,
+    0x1p-1f, 0x1.555556p-2f, 0x1.555556p-3f, 0x1.555556p-3f, 0x1.555556p-2f, 0x1p-1f, 0x1.555556p-1f, 0x1.aaaaaap-1f,
+    0x1p+0f, 0x1.b6db6ep-1f, 0x1.6db6dcp-1f, 0x1.24924ap-1f, 0x1.b6db6ep-2f, 0x1.24924ap-2f, 0x1.24924ap-3f, 0x1.24924ap-3f,
+    0x1.24924ap-2f, 0x1.b6db6ep-2f, 0x1.24924ap-1f, 0x1.6db6dcp-1f, 0x1.b6db6ep-1f, 0x1p+0f, 0x1.b6db6ep-1f, 0x1.6db6dcp-1f,
+    0x1.24924ap-1f, 0x1.b6db6ep-2f, 0x1.24924ap-2f, 0x1.24924ap-3f, 0x1.24924ap-3f, 0x1.24924ap-2f, 0x1.b6db6ep-2f, 0x1.24924ap-1f,
+    0x1.6db6dcp-1f, 0x1.b6db6ep-1f, 0x1p+0f, 0x1.cp-1f, 0x1.8p-1f, 0x1.4p-1f, 0x1p-1f, 0x1.8p-2f,
+    0x1p-2f, 0x1p-3f, 0x1p-3f, 0x1p-2f, 0x1.8p-2f, 0x1p-1f, 0x1.4p-1f, 0x1.8p-1f,
+    0x1.cp-1f, 0x1p+0f, 0x1.b6db6ep-1f, 0x1.6db6dcp-1f, 0x1.24924ap-1f, 0x1.b6db6ep-2f, 0x1.24924ap-2f, 0x1.24924ap-3f,
+    0x1.24924ap-3f, 0x1.24924ap-2f, 0x1.b6db6ep-2f, 0x1.24924ap-1f, 0x1.6db6dcp-1f, 0x1.b6db6ep-1f, 0x1p+0f, 0x1.c71c72p-1f,
+    0x1.8e38e4p-1f, 0x1.555556p-1f, 0x1.1c71c8p-1f, 0x1.c71c72p-2f, 0x1.555556p-2f, 0x1.c71c72p-3f, 0x1.c71c72p-4f, 0x1.c71c72p-4f,
+    0x1.c71c72p-3f, 0x1.555556p-2f, 0x1.c71c72p-2f, 0x1.1c71c8p-1f, 0x1.555556p-1f, 0x1.8e38e4p-1f, 0x1.c71c72p-1f, 0x1p+0f,
+    0x1.c71c72p-1f, 0x1.8e38e4p-1f, 0x1.555556p-1f, 0x1.1c71c8p-1f, 0x1.c71c72p-2f, 0x1.555556p-2f, 0x1.c71c72p-3f, 0x1.c71c72p-4f,
+    0x1.c71c72p-4f, 0x1.c71c72p-3f, 0x1.555556p-2f, 0x1.c71c72p-2f, 0x1.1c71c8p-1f, 0x1.555556p-1f, 0x1.8e38e4p-1f, 0x1.c71c72p-1f,
+    0x1p+0f, 0x1.c71c72p-1f, 0x1.8e38e4p-1f, 0x1.555556p-1f, 0x1.1c71c8p-1f, 0x1.c71c72p-2f, 0x1.555556p-2f, 0x1.c71c72p-3f,
+    0x1.c71c72p-4f, 0x1.c71c72p-4f, 0x1.c71c72p-3f, 0x1.555556p-2f, 0x1.c71c72p-2f, 0x1.1c71c8p-1f, 0x1.555556p-1f, 0x1.8e38e4p-1f,
+    0x1.c71c72p-1f, 0x1p+0f, 0x1.d1745ep-1f, 0x1.a2e8bap-1f, 0x1.745d18p-1f, 0x1.45d174p-1f, 0x1.1745d2p-1f, 0x1.d1745ep-2f,
+    0x1.745d18p-2f, 0x1.1745d2p-2f, 0x1.745d18p-3f, 0x1.745d18p-4f, 0x1.745d18p-4f, 0x1.745d18p-3f, 0x1.1745d2p-2f, 0x1.745d18p-2f,
+    0x1.d1745ep-2f, 0x1.1745d2p-1f, 0x1.45d174p-1f, 0x1.745d18p-1f, 0x1.a2e8bap-1f, 0x1.d1745ep-1f, 0x1p+0f, 0x1.ccccccp-1f,
+    0x1.99999ap-1f, 0x1.666666p-1f, 0x1.333334p-1f, 0x1p-1f, 0x1.99999ap-2f, 0x1.333334p-2f, 0x1.99999ap-3f, 0x1.99999ap-4f,
+    0x1.99999ap-4f, 0x1.99999ap-3f, 0x1.333334p-2f, 0x1.99999ap-2f, 0x1p-1f, 0x1.333334p-1f, 0x1.666666p-1f, 0x1.99999ap-1f,
+    0x1.ccccccp-1f, 0x1p+0f, 0x1.d55556p-1f, 0x1.aaaaaap-1f, 0x1.8p-1f, 0x1.555556p-1f, 0x1.2aaaaap-1f, 0x1p-1f,
+    0x1.aaaaaap-2f, 0x1.555556p-2f, 0x1p-2f, 0x1.555556p-3f, 0x1.555556p-4f, 0x1.555556p-4f, 0x1.555556p-3f, 0x1p-2f,
+    0x1.555556p-2f, 0x1.aaaaaap-2f, 0x1p-1f, 0x1.2aaaaap-1f, 0x1.555556p-1f, 0x1.8p-1f, 0x1.aaaaaap-1f, 0x1.d55556p-1f,
+    0x1p+0f, 0x1.d55556p-1f, 0x1.aaaaaap-1f, 0x1.8p-1f, 0x1.555556p-1f, 0x1.2aaaaap-1f, 0x1p-1f, 0x1.aaaaaap-2f,
+    0x1.555556p-2f, 0x1p-2f, 0x1.555556p-3f, 0x1.555556p-4f, 0x1.555556p-4f, 0x1.555556p-3f, 0x1p-2f, 0x1.555556p-2f,
+    0x1.aaaaaap-2f, 0x1p-1f, 0x1.2aaaaap-1f, 0x1.555556p-1f, 0x1.8p-1f, 0x1.aaaaaap-1f, 0x1.d55556p-1f, 0x1p+0f,
+    0x1.d89d8ap-1f, 0x1.b13b14p-1f, 0x1.89d89ep-1f, 0x1.627628p-1f, 0x1.3b13b2p-1f, 0x1.13b13cp-1f, 0x1.d89d8ap-2f, 0x1.89d89ep-2f,
+    0x1.3b13b2p-2f, 0x1.d89d8ap-3f, 0x1.3b13b2p-3f, 0x1.3b13b2p-4f, 0x1.3b13b2p-4f, 0x1.3b13b2p-3f, 0x1.d89d8ap-3f, 0x1.3b13b2p-2f,
+    0x1.89d89ep-2f, 0x1.d89d8ap-2f, 0x1.13b13cp-1f, 0x1.3b13b2p-1f, 0x1.627628p-1f, 0x1.89d89ep-1f, 0x1.b13b14p-1f, 0x1.d89d8ap-1f,
+    0x1p+0f, 0x1.db6db6p-1f, 0x1.b6db6ep-1f, 0x1.924924p-1f, 0x1.6db6dcp-1f, 0x1.492492p-1f, 0x1.24924ap-1f, 0x1p-1f,
+    0x1.b6db6ep-2f, 0x1.6db6dcp-2f, 0x1.24924ap-2f, 0x1.b6db6ep-3f, 0x1.24924ap-3f, 0x1.24924ap-4f, 0x1.24924ap-4f, 0x1.24924ap-3f,
+    0x1.b6db6ep-3f, 0x1.24924ap-2f, 0x1.6db6dcp-2f, 0x1.b6db6ep-2f, 0x1p-1f, 0x1.24924ap-1f, 0x1.492492p-1f, 0x1.6db6dcp-1f,
+    0x1.924924p-1f, 0x1.b6db6ep-1f, 0x1.db6db6p-1f, 0x1p+0f, 0x1.dddddep-1f, 0x1.bbbbbcp-1f, 0x1.99999ap-1f, 0x1.777778p-1f,
+    0x1.555556p-1f, 0x1.333334p-1f, 0x1.111112p-1f, 0x1.dddddep-2f, 0x1.99999ap-2f, 0x1.555556p-2f, 0x1.111112p-2f, 0x1.99999ap-3f,
+    0x1.111112p-3f, 0x1.111112p-4f, 0x1.111112p-4f, 0x1.111112p-3f, 0x1.99999ap-3f, 0x1.111112p-2f, 0x1.555556p-2f, 0x1.99999ap-2f,
+    0x1.dddddep-2f, 0x1.111112p-1f, 0x1.333334p-1f, 0x1.555556p-1f, 0x1.777778p-1f, 0x1.99999ap-1f, 0x1.bbbbbcp-1f, 0x1.dddddep-1f,
+    0x1p+0f, 0x1.dddddep-1f, 0x1.bbbbbcp-1f, 0x1.99999ap-1f, 0x1.777778p-1f, 0x1.555556p-1f, 0x1.333334p-1f, 0x1.111112p-1f,
+    0x1.dddddep-2f, 0x1.99999ap-2f, 0x1.555556p-2f, 0x1.111112p-2f, 0x1.99999ap-3f, 0x1.111112p-3f, 0x1.111112p-4f, 0x1.111112p-4f,
+    0x1.111112p-3f, 0x1.99999ap-3f, 0x1.111112p-2f, 0x1.555556p-2f, 0x1.99999ap-2f, 0x1.dddddep-2f, 0x1.111112p-1f, 0x1.333334p-1f,
+    0x1.555556p-1f, 0x1.777778p-1f, 0x1.99999ap-1f, 0x1.bbbbbcp-1f, 0x1.dddddep-1f, 0x1p+0f, 0x1.e1e1e2p-1f, 0x1.c3c3c4p-1f,
+    0x1.a5a5a6p-1f, 0x1.878788p-1f, 0x1.69696ap-1f, 0x1.4b4b4cp-1f, 0x1.2d2d2ep-1f, 0x1.0f0f1p-1f, 0x1.e1e1e2p-2f, 0x1.a5a5a6p-2f,
+    0x1.69696ap-2f, 0x1.2d2d2ep-2f, 0x1.e1e1e2p-3f, 0x1.69696ap-3f, 0x1.e1e1e2p-4f, 0x1.e1e1e2p-5f,
+};
+
+// Seeds the process-wide plan cache, so filterbanks with these parameters skip the mel math
+inline void register_plan() {
+    signalflow::register_mel_filter_plan(std::make_shared<const signalflow::MelFilterPlan>(
+        kKey, std::span<const uint32_t>(kStartBins), std::span<const uint32_t>(kOffsets),
+        std::span<const float>(kWeights)));
+}
+
+}
@@ -0,0 +1,93 @@
+// Verifies that the span-based hot path does no heap allocation after warm-up.
+// Global operator new/delete are replaced with counting versions for this binary.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+#include <signalflow/mel_spectrogram.hpp>
+#include <signalflow/static_pipeline.hpp>
+
+namespace {
+std::atomic<size_t> g_allocations{0};
+
+void* counted_alloc(size_t size, size_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* p = alignment > alignof(std::max_align_t)
+        ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+        : std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+}
+
+void* operator new(size_t size) { return counted_alloc(size, alignof(std::max_align_t)); }
+void* operator new[](size_t size) { return counted_alloc(size, alignof(std::max_align_t)); }
+void* operator new(size_t size, std::align_val_t al) { return counted_alloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return counted_alloc(size, static_cast<size_t>(al)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+// Each stage's span overload writes into caller buffers without allocating
+TEST(AllocationTest, StageSpanOverloadsDoNotAllocate) {
+    const size_t N = 512;
+    signalflow::CircularBuffer<float> buf(N);
+    signalflow::Window window(N);
+    signalflow::FFT fft(N);
+    signalflow::MelFilterBank mel_bank(N, 16000, 40);
+    std::vector<float> windowed(N), magnitudes(fft.num_bins()), mel(40);
+
+    size_t before = g_allocations.load();
+    for (int frame = 0; frame < 100; ++frame) {
+        for (size_t i = 0; i < N; ++i) buf.push(std::sin(0.05f * (frame * N + i)));
+        window.apply(buf, windowed);
+        fft.compute_magnitude(windowed, magnitudes);
+        mel_bank.apply(magnitudes, mel);
+    }
+    EXPECT_EQ(g_allocations.load() - before, 0u);
+}
+
+// The streaming pipeline does not allocate once constructed
+TEST(AllocationTest, MelSpectrogramSteadyStateDoesNotAllocate) {
+    const size_t N = 1024;
+    const size_t hop = 512;
+    signalflow::MelSpectrogram spectrogram(N, hop, 16000, 40);
+    std::vector<float> chunk(300);
+    size_t frames = 0;
+    float checksum = 0.0f;
+    auto on_frame = [&](std::span<const float> mel) { checksum += mel[0]; ++frames; };
+
+    // Warm-up: fill the first frame
+    for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = std::sin(0.01f * i);
+    for (int k = 0; k < 4; ++k) spectrogram.process(chunk, on_frame);
+
+    size_t before = g_allocations.load();
+    for (int k = 0; k < 500; ++k) spectrogram.process(chunk, on_frame);
+    EXPECT_EQ(g_allocations.load() - before, 0u);
+    EXPECT_GT(frames, 200u);
+}
+
+// The compile-time pipeline never allocates, not even during construction
+TEST(AllocationTest, StaticMelPipelineNeverAllocates) {
+    std::vector<float> chunk(300);
+    for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = std::sin(0.01f * i);
+    float checksum = 0.0f;
+
+    size_t before = g_allocations.load();
+    {
+        signalflow::StaticMelPipeline<1024, 512, 40, 16000> pipeline;
+        for (int k = 0; k < 100; ++k) {
+            pipeline.process(chunk, [&](std::span<const float> mel) { checksum += mel[0]; });
+        }
+    }
+    EXPECT_EQ(g_allocations.load() - before, 0u);
+    EXPECT_NE(checksum, 0.0f);
+}
@@ -0,0 +1,126 @@
+// Per-stage instrumentation. This binary is built with SIGNALFLOW_INSTRUMENT=1, so the
+// header-only pipeline code records into the histograms.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+#include <signalflow/instrument.hpp>
+#include <signalflow/mel_spectrogram.hpp>
+#include <signalflow/batch.hpp>
+#include <signalflow/stream_engine.hpp>
+
+namespace instrument = signalflow::instrument;
+
+// Test buckets: every value falls in a bucket whose upper bound is within 1/16 above it
+TEST(InstrumentTest, BucketsBoundRelativeError) {
+    std::mt19937_64 rng(7);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t ticks = rng() >> (rng() % 40 + 24);
+        size_t index = instrument::detail::bucket_index(ticks);
+        ASSERT_LT(index, instrument::detail::kBuckets);
+        uint64_t upper = instrument::detail::bucket_upper(index);
+        EXPECT_GE(upper, ticks);
+        EXPECT_LE(upper - ticks, ticks / 16) << "ticks=" << ticks;
+        if (index > 0) {
+            EXPECT_LT(instrument::detail::bucket_upper(index - 1), ticks);
+        }
+    }
+}
+
+// Test MelSpectrogram: every stage is timed once per frame (ingest once per push)
+TEST(InstrumentTest, MelSpectrogramRecordsEveryStage) {
+    static_assert(instrument::enabled());
+    instrument::reset();
+
+    signalflow::MelSpectrogram spectrogram(512, 256, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+                                           signalflow::FFTBackend::Kiss, signalflow::LogMelOptions{});
+    std::vector<float> chunk(256);
+    for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = std::sin(0.03f * i);
+    size_t frames = 0;
+    for (int k = 0; k < 200; ++k) {
+        frames += spectrogram.process(chunk, [](std::span<const float>) {});
+    }
+
+    auto snap = instrument::snapshot();
+    EXPECT_EQ(snap.frames, frames);
+    EXPECT_EQ(snap[instrument::Stage::Ingest].count, 200u);
+    for (auto stage : {instrument::Stage::Window, instrument::Stage::FFT, instrument::Stage::FilterBank,
+                       instrument::Stage::PostProcess, instrument::Stage::Callback}) {
+        const auto& stats = snap[stage];
+        EXPECT_EQ(stats.count, frames) << instrument::name(stage);
+        EXPECT_LE(stats.p50_ns, stats.p99_ns);
+        EXPECT_LE(stats.p99_ns, stats.max_ns);
+        EXPECT_GT(stats.mean_ns, 0.0);
+    }
+    EXPECT_GT(snap[instrument::Stage::FFT].p50_ns, 0.0);
+
+    instrument::reset();
+    EXPECT_EQ(instrument::snapshot().frames, 0u);
+}
+
+// Test threads: each records into its own histograms and exited threads still count
+TEST(InstrumentTest, MergesThreads) {
+    instrument::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 1000; ++i) {
+                instrument::detail::record(instrument::Stage::Callback, 100 + t);
+                instrument::detail::count_frame();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    auto snap = instrument::snapshot();
+    EXPECT_EQ(snap.frames, 4000u);
+    EXPECT_EQ(snap[instrument::Stage::Callback].count, 4000u);
+    EXPECT_EQ(snap[instrument::Stage::Window].count, 0u);
+    EXPECT_GE(snap[instrument::Stage::Callback].max_ns, snap[instrument::Stage::Callback].p50_ns);
+}
+
+// Test BatchMelSpectrogram: window and FFT per frame, the filterbank per apply_batch block
+TEST(InstrumentTest, BatchRecordsStages) {
+    instrument::reset();
+    signalflow::BatchMelSpectrogram batch(512, 256, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann, 2);
+    std::vector<float> signal(16000);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.03f * i);
+    auto mel = batch.process(signal);
+
+    auto snap = instrument::snapshot();
+    EXPECT_EQ(snap.frames, mel.frames);
+    EXPECT_EQ(snap[instrument::Stage::Window].count, mel.frames);
+    EXPECT_EQ(snap[instrument::Stage::FFT].count, mel.frames);
+    EXPECT_GE(snap[instrument::Stage::FilterBank].count, 1u);
+    EXPECT_LE(snap[instrument::Stage::FilterBank].count, mel.frames);
+    EXPECT_EQ(snap[instrument::Stage::Callback].count, 0u);
+}
+
+// Test StreamEngine: ingest per push, window/FFT/post-process/callback per frame
+TEST(InstrumentTest, StreamEngineRecordsStages) {
+    instrument::reset();
+    signalflow::StreamEngine engine(512, 256, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann, 2,
+                                    signalflow::FFTBackend::Kiss, signalflow::LogMelOptions{});
+    std::vector<float> chunk(256);
+    for (size_t i = 0; i < chunk.size(); ++i) chunk[i] = std::sin(0.03f * i);
+    std::vector<signalflow::StreamEngine::StreamId> ids;
+    for (int s = 0; s < 5; ++s) ids.push_back(engine.add_stream());
+    size_t frames = 0;
+    for (int k = 0; k < 20; ++k) {
+        for (auto id : ids) engine.push(id, chunk);
+        frames += engine.process([](signalflow::StreamEngine::StreamId, std::span<const float>) {});
+    }
+
+    auto snap = instrument::snapshot();
+    EXPECT_GT(frames, 0u);
+    EXPECT_EQ(snap.frames, frames);
+    EXPECT_EQ(snap[instrument::Stage::Ingest].count, 100u);
+    for (auto stage : {instrument::Stage::Window, instrument::Stage::FFT, instrument::Stage::PostProcess,
+                       instrument::Stage::Callback}) {
+        EXPECT_EQ(snap[stage].count, frames) << instrument::name(stage);
+    }
+    EXPECT_GE(snap[instrument::Stage::FilterBank].count, 1u);
+    EXPECT_LE(snap[instrument::Stage::FilterBank].count, frames);
+}
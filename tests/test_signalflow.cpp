@@ -3,6 +3,26 @@
 #include <signalflow/window.hpp>
 #include <signalflow/fft.hpp>
 #include <signalflow/mel_scale.hpp>
+#include <signalflow/mel_plan.hpp>
+#include <signalflow/mel_spectrogram.hpp>
+#include <signalflow/simd.hpp>
+#include <signalflow/batch.hpp>
+#include <signalflow/wav_reader.hpp>
+#include <signalflow/static_pipeline.hpp>
+#include <signalflow/spsc_ring.hpp>
+#include <signalflow/log_mel.hpp>
+#include <signalflow/codec.hpp>
+#include <signalflow/stream_engine.hpp>
+#include <signalflow/feature_file.hpp>
+#include "mel_plan_512_40.hpp"
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <thread>
+#include <mutex>
+#include <chrono>
 
 // Test CircularBuffer basic push/at behavior
 TEST(CircularBufferTest, PushAndAt) {
@@ -30,6 +50,59 @@ TEST(CircularBufferTest, OutOfBoundsAccess) {
     EXPECT_ANY_THROW(buffer.at(2));
 }
 
+// Test CircularBuffer segments: oldest-to-newest across the wrap point
+TEST(CircularBufferTest, SegmentsAndBulkPush) {
+    signalflow::CircularBuffer<float> buffer(5);
+    std::vector<float> first = {1.0f, 2.0f, 3.0f};
+    buffer.push(first);
+    EXPECT_FALSE(buffer.is_full());
+    EXPECT_EQ(buffer.size(), 3u);
+    auto [a, b] = buffer.segments();
+    EXPECT_EQ(std::vector<float>(a.begin(), a.end()), first);
+    EXPECT_TRUE(b.empty());
+
+    std::vector<float> second = {4.0f, 5.0f, 6.0f, 7.0f}; // wraps
+    buffer.push(second);
+    EXPECT_TRUE(buffer.is_full());
+    auto [older, newer] = buffer.segments();
+    std::vector<float> joined(older.begin(), older.end());
+    joined.insert(joined.end(), newer.begin(), newer.end());
+    EXPECT_EQ(joined, (std::vector<float>{3.0f, 4.0f, 5.0f, 6.0f, 7.0f}));
+    // Bulk push agrees with per-sample push
+    EXPECT_FLOAT_EQ(buffer.at(0), 7.0f);
+    EXPECT_FLOAT_EQ(buffer.at(4), 3.0f);
+
+    // More than capacity keeps only the newest values
+    std::vector<float> many = {10, 11, 12, 13, 14, 15, 16};
+    buffer.push(many);
+    for (size_t i = 0; i < 5; ++i) EXPECT_FLOAT_EQ(buffer.at(i), 16.0f - i);
+}
+
+// Test CircularBuffer move: storage transfers and the source is left empty
+TEST(CircularBufferTest, Move) {
+    signalflow::CircularBuffer<int> buffer(3);
+    buffer.push(1);
+    buffer.push(2);
+    signalflow::CircularBuffer<int> moved(std::move(buffer));
+    EXPECT_EQ(moved.at(0), 2);
+    EXPECT_EQ(moved.size(), 2u);
+    EXPECT_EQ(buffer.capacity(), 0u);
+
+    signalflow::CircularBuffer<int> assigned(1);
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.at(1), 1);
+    EXPECT_EQ(assigned.capacity(), 3u);
+
+    // Assigning into a buffer on another resource allocates there, and a full arena
+    // reports bad_alloc rather than terminating
+    static_assert(std::is_nothrow_move_constructible_v<signalflow::CircularBuffer<int>>);
+    static_assert(!std::is_nothrow_move_assignable_v<signalflow::CircularBuffer<int>>);
+    alignas(signalflow::kArenaAlignment) std::byte block[16];
+    std::pmr::monotonic_buffer_resource full(block, sizeof(block), std::pmr::null_memory_resource());
+    signalflow::CircularBuffer<int> in_arena(0, &full);
+    EXPECT_THROW(in_arena = signalflow::CircularBuffer<int>(64), std::bad_alloc);
+}
+
 // Test Window coefficients sum to ~1 for Hann
 TEST(WindowTest, HannSum) {
     size_t N = 128;
@@ -48,9 +121,25 @@ TEST(WindowTest, ShortBuffer) {
     signalflow::Window window(N);
     signalflow::CircularBuffer<float> buf(N);
     for (size_t i = 0; i < N/2; ++i) buf.push(1.0f); // Only half full
-    // Should still return a vector of size N, but may be zeros or garbage for uninitialized
+    // Should still return a vector of size N; the missing oldest samples read as zero
     auto win = window.apply(buf);
     EXPECT_EQ(win.size(), N);
+    EXPECT_FALSE(buf.is_full());
+    for (size_t i = 0; i < N/2; ++i) EXPECT_FLOAT_EQ(win[i], 0.0f);
+    EXPECT_GT(win[N/2 + 1], 0.0f);
+}
+
+// Test Window: segment-based windowing matches the per-sample at() definition after wrapping
+TEST(WindowTest, MatchesAtAcrossWrap) {
+    size_t N = 16;
+    signalflow::Window window(N, signalflow::Window::Type::Hamming);
+    signalflow::CircularBuffer<float> buf(N);
+    for (size_t i = 0; i < N + 5; ++i) buf.push(static_cast<float>(i) * 0.5f);
+    signalflow::CircularBuffer<float> ones(N);
+    for (size_t i = 0; i < N; ++i) ones.push(1.0f);
+    auto coeffs = window.apply(ones);
+    auto win = window.apply(buf);
+    for (size_t i = 0; i < N; ++i) EXPECT_FLOAT_EQ(win[i], buf.at(N - 1 - i) * coeffs[i]);
 }
 
 // Test FFT: single impulse
@@ -118,4 +207,1127 @@ TEST(SignalFlowTest, MelSpectrumSineWave) {
     // Assert that Bin 14 (around 1000Hz) is much larger than Bin 0
     ASSERT_GT(mel_bins[14], 100.0f);
     ASSERT_LT(mel_bins[0], 1.0f);
-}
\ No newline at end of file
+}
+
+// Test MelSpectrogram: streaming output matches the frame-by-frame chain regardless of chunk size
+TEST(MelSpectrogramTest, MatchesManualFraming) {
+    const size_t N = 256;
+    const size_t hop = 64;
+    const int sample_rate = 16000;
+    std::vector<float> signal(N * 6);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = std::sin(2.0 * M_PI * 440.0 * i / sample_rate) + 0.1f * std::sin(0.37 * i);
+    }
+
+    // Reference: rebuild a buffer for every frame, like the original demo loop
+    signalflow::Window window(N);
+    signalflow::FFT fft(N);
+    signalflow::MelFilterBank mel_bank(N, sample_rate, 20);
+    std::vector<std::vector<float>> expected;
+    for (size_t start = 0; start + N <= signal.size(); start += hop) {
+        signalflow::CircularBuffer<float> buf(N);
+        for (size_t i = 0; i < N; ++i) buf.push(signal[start + i]);
+        expected.push_back(mel_bank.apply(fft.compute_magnitude(window.apply(buf))));
+    }
+
+    for (size_t chunk : {size_t(1), size_t(7), size_t(64), size_t(1000)}) {
+        signalflow::MelSpectrogram spectrogram(N, hop, sample_rate, 20);
+        std::vector<std::vector<float>> frames;
+        for (size_t offset = 0; offset < signal.size(); offset += chunk) {
+            size_t count = std::min(chunk, signal.size() - offset);
+            spectrogram.process(std::span<const float>(signal.data() + offset, count),
+                [&](std::span<const float> mel) { frames.emplace_back(mel.begin(), mel.end()); });
+        }
+        ASSERT_EQ(frames.size(), expected.size()) << "chunk " << chunk;
+        for (size_t f = 0; f < frames.size(); ++f) {
+            for (size_t m = 0; m < frames[f].size(); ++m) {
+                EXPECT_FLOAT_EQ(frames[f][m], expected[f][m]);
+            }
+        }
+    }
+}
+
+// Error handling: MelSpectrogram rejects a hop that is zero or larger than the frame
+TEST(MelSpectrogramTest, InvalidHop) {
+    EXPECT_THROW(signalflow::MelSpectrogram(256, 0, 16000), std::invalid_argument);
+    EXPECT_THROW(signalflow::MelSpectrogram(256, 512, 16000), std::invalid_argument);
+}
+
+// Test SIMD kernels: every level this CPU supports agrees with the scalar path
+TEST(SimdTest, KernelsMatchScalar) {
+    using signalflow::simd::Level;
+    for (size_t n : {size_t(1), size_t(7), size_t(16), size_t(33), size_t(513)}) {
+        std::vector<float> cpx(2 * n), a(n), b(n);
+        for (size_t i = 0; i < 2 * n; ++i) cpx[i] = std::sin(0.7f * i) * 3.0f - 0.5f;
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = std::cos(0.3f * i);
+            b[i] = 0.25f + 0.01f * i;
+        }
+        std::vector<float> ref_mag(n), ref_pow(n);
+        signalflow::simd::magnitude(cpx.data(), ref_mag.data(), n, Level::Scalar);
+        signalflow::simd::power(cpx.data(), ref_pow.data(), n, Level::Scalar);
+        float ref_dot = signalflow::simd::dot(a.data(), b.data(), n, Level::Scalar);
+
+        for (Level level : {Level::NEON, Level::AVX2, Level::AVX512}) {
+            if (!signalflow::simd::supported(level)) continue;
+            SCOPED_TRACE(signalflow::simd::name(level));
+            std::vector<float> mag(n), pow(n);
+            signalflow::simd::magnitude(cpx.data(), mag.data(), n, level);
+            signalflow::simd::power(cpx.data(), pow.data(), n, level);
+            for (size_t i = 0; i < n; ++i) {
+                EXPECT_NEAR(mag[i], ref_mag[i], 1e-5f * (1.0f + ref_mag[i]));
+                EXPECT_NEAR(pow[i], ref_pow[i], 1e-5f * (1.0f + ref_pow[i]));
+            }
+            EXPECT_NEAR(signalflow::simd::dot(a.data(), b.data(), n, level), ref_dot, 1e-4f * (1.0f + std::abs(ref_dot)));
+        }
+
+        // Levels the CPU lacks run as active() rather than faulting
+        for (Level level : {Level::NEON, Level::AVX2, Level::AVX512}) {
+            if (signalflow::simd::supported(level)) continue;
+            std::vector<float> mag(n), expected(n);
+            signalflow::simd::magnitude(cpx.data(), mag.data(), n, level);
+            signalflow::simd::magnitude(cpx.data(), expected.data(), n, signalflow::simd::active());
+            EXPECT_EQ(mag, expected) << signalflow::simd::name(level);
+            EXPECT_EQ(signalflow::simd::dot(a.data(), b.data(), n, level),
+                      signalflow::simd::dot(a.data(), b.data(), n, signalflow::simd::active()));
+        }
+    }
+}
+
+// Test FFT power spectrum: square of the magnitude spectrum
+TEST(FFTTest, PowerIsSquaredMagnitude) {
+    size_t N = 128;
+    signalflow::FFT fft(N);
+    std::vector<float> x(N);
+    for (size_t i = 0; i < N; ++i) x[i] = std::sin(0.2f * i) + 0.5f;
+    std::vector<float> mag(fft.num_bins()), pow(fft.num_bins());
+    fft.compute_magnitude(x, mag);
+    fft.compute_power(x, pow);
+    for (size_t i = 0; i < mag.size(); ++i) EXPECT_NEAR(pow[i], mag[i] * mag[i], 1e-4f * (1.0f + pow[i]));
+}
+
+// Test MelFilterBank packed layout: apply equals a naive sum over each filter view
+TEST(MelFilterBankTest, PackedLayoutMatchesFilters) {
+    size_t N = 512;
+    signalflow::MelFilterBank mel(N, 16000, 40);
+    std::vector<float> mag(N/2+1);
+    for (size_t i = 0; i < mag.size(); ++i) mag[i] = 1.0f + std::sin(0.1f * i);
+    auto out = mel.apply(mag);
+    for (size_t m = 0; m < mel.n_mels(); ++m) {
+        auto filter = mel.filter(m);
+        float expected = 0.0f;
+        for (size_t j = 0; j < filter.weights.size(); ++j) {
+            if (filter.start_bin + j < mag.size()) expected += mag[filter.start_bin + j] * filter.weights[j];
+        }
+        EXPECT_NEAR(out[m], expected, 1e-4f * (1.0f + expected));
+    }
+}
+
+// Test ThreadPool: every index is visited exactly once and exceptions reach the caller
+TEST(ThreadPoolTest, ParallelForCoversRangeAndPropagatesErrors) {
+    signalflow::ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallel_for(hits.size(), 7, [&](size_t begin, size_t end, size_t worker) {
+        EXPECT_LT(worker, pool.size());
+        for (size_t i = begin; i < end; ++i) hits[i]++;
+    });
+    for (auto& h : hits) EXPECT_EQ(h.load(), 1);
+
+    EXPECT_THROW(pool.parallel_for(100, 1, [](size_t begin, size_t, size_t) {
+        if (begin == 42) throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+// Test ThreadPool: the stealing loop also covers every index once, including uneven work
+TEST(ThreadPoolTest, ParallelForStealingBalancesUnevenWork) {
+    signalflow::ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(5000);
+    std::vector<std::atomic<int>> per_worker(pool.size());
+    pool.parallel_for_stealing(hits.size(), 3, [&](size_t begin, size_t end, size_t worker) {
+        for (size_t i = begin; i < end; ++i) {
+            hits[i]++;
+            // The first slice is far more expensive, so the other workers must steal it
+            if (i < hits.size() / 4) std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+        per_worker[worker] += static_cast<int>(end - begin);
+    });
+    for (auto& h : hits) EXPECT_EQ(h.load(), 1);
+
+    EXPECT_THROW(pool.parallel_for_stealing(100, 1, [](size_t begin, size_t, size_t) {
+        if (begin == 42) throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+// Test BatchMelSpectrogram: bit-identical to the streaming path, for any thread count and per channel
+TEST(BatchMelSpectrogramTest, MatchesStreamingBitForBit) {
+    const size_t N = 512;
+    const size_t hop = 160;
+    const int sample_rate = 16000;
+    std::vector<float> left(sample_rate), right(sample_rate / 3);
+    for (size_t i = 0; i < left.size(); ++i) left[i] = std::sin(2.0 * M_PI * 523.0 * i / sample_rate);
+    for (size_t i = 0; i < right.size(); ++i) right[i] = 0.3f * std::sin(0.011 * i * i / 100.0);
+
+    auto stream = [&](const std::vector<float>& signal) {
+        signalflow::MelSpectrogram spectrogram(N, hop, sample_rate, 64);
+        std::vector<float> flat;
+        spectrogram.process(signal, [&](std::span<const float> mel) { flat.insert(flat.end(), mel.begin(), mel.end()); });
+        return flat;
+    };
+    auto expected_left = stream(left);
+    auto expected_right = stream(right);
+
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        signalflow::BatchMelSpectrogram batch(N, hop, sample_rate, 64, 0.0f, 8000.0f,
+                                              signalflow::Window::Type::Hann, threads);
+        auto single = batch.process(left);
+        EXPECT_EQ(single.frames, batch.frame_count(left.size()));
+        EXPECT_EQ(single.data, expected_left);
+
+        std::vector<std::span<const float>> channels = {left, right};
+        auto multi = batch.process(channels);
+        ASSERT_EQ(multi.size(), 2u);
+        EXPECT_EQ(multi[0].data, expected_left);
+        EXPECT_EQ(multi[1].data, expected_right);
+        EXPECT_EQ(multi[1].n_mels, 64u);
+    }
+
+    // A signal shorter than one frame yields an empty matrix
+    signalflow::BatchMelSpectrogram batch(N, hop, sample_rate, 64);
+    EXPECT_EQ(batch.process(std::span<const float>(left.data(), N - 1)).frames, 0u);
+}
+
+// Test MelFilterBank::apply_batch: bit-identical to per-frame apply, including partial blocks
+TEST(MelFilterBankTest, ApplyBatchMatchesApply) {
+    size_t N = 1024;
+    size_t n_bins = N / 2 + 1;
+    size_t frames = 75; // Not a multiple of the row grouping
+    signalflow::MelFilterBank mel(N, 16000, 80);
+    std::vector<float> block(frames * n_bins);
+    for (size_t i = 0; i < block.size(); ++i) block[i] = std::abs(std::sin(0.013f * i)) * 10.0f;
+
+    std::vector<float> batched(frames * mel.n_mels());
+    mel.apply_batch(block, n_bins, batched);
+    std::vector<float> single(mel.n_mels());
+    for (size_t f = 0; f < frames; ++f) {
+        mel.apply(std::span<const float>(block).subspan(f * n_bins, n_bins), single);
+        for (size_t m = 0; m < mel.n_mels(); ++m) EXPECT_EQ(batched[f * mel.n_mels() + m], single[m]);
+    }
+
+    EXPECT_THROW(mel.apply_batch(std::span<const float>(block).first(n_bins + 1), n_bins, batched), std::invalid_argument);
+}
+
+// Test SIMD dot_rows: every row equals dot() exactly at each supported level
+TEST(SimdTest, DotRowsMatchesDot) {
+    using signalflow::simd::Level;
+    const size_t stride = 70;
+    const size_t rows = 9;
+    std::vector<float> data(rows * stride), w(stride);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = std::sin(0.37f * i);
+    for (size_t i = 0; i < w.size(); ++i) w[i] = std::cos(0.11f * i);
+    for (Level level : {Level::Scalar, Level::NEON, Level::AVX2, Level::AVX512}) {
+        if (!signalflow::simd::supported(level)) continue;
+        SCOPED_TRACE(signalflow::simd::name(level));
+        for (size_t n : {size_t(3), size_t(16), size_t(29), size_t(64)}) {
+            std::vector<float> out(rows * 2);
+            signalflow::simd::dot_rows(data.data(), stride, rows, w.data(), n, out.data(), 2, level);
+            for (size_t r = 0; r < rows; ++r) {
+                EXPECT_EQ(out[r * 2], signalflow::simd::dot(data.data() + r * stride, w.data(), n, level));
+            }
+        }
+    }
+}
+
+// Writes a WAV with dr_wav and checks WavReader against a full dr_wav decode + down-mix
+static void check_wav_reader(const char* name, drwav_uint32 format, drwav_uint32 bits, drwav_uint32 channels) {
+    SCOPED_TRACE(name);
+    const size_t frames = 5000;
+    std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+
+    drwav_data_format fmt{};
+    fmt.container = drwav_container_riff;
+    fmt.format = format;
+    fmt.channels = channels;
+    fmt.sampleRate = 16000;
+    fmt.bitsPerSample = bits;
+    drwav writer;
+    ASSERT_TRUE(drwav_init_file_write(&writer, path.c_str(), &fmt, nullptr));
+    std::vector<float> source(frames * channels);
+    for (size_t i = 0; i < source.size(); ++i) source[i] = 0.8f * std::sin(0.01f * i + (i % channels));
+    if (format == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        drwav_write_pcm_frames(&writer, frames, source.data());
+    } else if (bits == 16) {
+        std::vector<drwav_int16> pcm(source.size());
+        for (size_t i = 0; i < pcm.size(); ++i) pcm[i] = static_cast<drwav_int16>(source[i] * 32767.0f);
+        drwav_write_pcm_frames(&writer, frames, pcm.data());
+    } else {
+        std::vector<unsigned char> pcm(source.size() * 3);
+        for (size_t i = 0; i < source.size(); ++i) {
+            int32_t v = static_cast<int32_t>(source[i] * 8388607.0f);
+            pcm[3 * i] = v & 0xFF; pcm[3 * i + 1] = (v >> 8) & 0xFF; pcm[3 * i + 2] = (v >> 16) & 0xFF;
+        }
+        drwav_write_pcm_frames(&writer, frames, pcm.data());
+    }
+    drwav_uninit(&writer);
+
+    unsigned int ref_channels = 0, ref_rate = 0;
+    drwav_uint64 ref_frames = 0;
+    float* ref = drwav_open_file_and_read_pcm_frames_f32(path.c_str(), &ref_channels, &ref_rate, &ref_frames, nullptr);
+    ASSERT_NE(ref, nullptr);
+
+    signalflow::WavReader reader(path.string());
+    EXPECT_EQ(reader.channels(), channels);
+    EXPECT_EQ(reader.sample_rate(), 16000u);
+    ASSERT_EQ(reader.total_frames(), ref_frames);
+    std::vector<float> mono;
+    std::vector<float> chunk(333); // Chunks that do not divide the file
+    while (size_t n = reader.read(chunk)) mono.insert(mono.end(), chunk.begin(), chunk.begin() + n);
+    ASSERT_EQ(mono.size(), frames);
+    for (size_t i = 0; i < frames; ++i) {
+        float sum = 0.0f;
+        for (size_t ch = 0; ch < channels; ++ch) sum += ref[i * channels + ch];
+        EXPECT_EQ(mono[i], sum / channels) << "frame " << i;
+    }
+    drwav_free(ref, nullptr);
+    std::filesystem::remove(path);
+}
+
+// Test WavReader: mapped PCM16 and float32 paths and the dr_wav decode fallback
+TEST(WavReaderTest, MatchesDrWavDecode) {
+    check_wav_reader("sf_pcm16_mono.wav", DR_WAVE_FORMAT_PCM, 16, 1);
+    check_wav_reader("sf_pcm16_stereo.wav", DR_WAVE_FORMAT_PCM, 16, 2);
+    check_wav_reader("sf_pcm16_3ch.wav", DR_WAVE_FORMAT_PCM, 16, 3);
+    check_wav_reader("sf_float_stereo.wav", DR_WAVE_FORMAT_IEEE_FLOAT, 32, 2);
+    check_wav_reader("sf_pcm24_stereo.wav", DR_WAVE_FORMAT_PCM, 24, 2);
+}
+
+// Error handling: WavReader on a missing or non-WAV file
+TEST(WavReaderTest, InvalidFile) {
+    EXPECT_THROW(signalflow::WavReader("/nonexistent/file.wav"), std::runtime_error);
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "sf_not_a_wav.wav";
+    FILE* f = std::fopen(path.c_str(), "wb");
+    std::fputs("definitely not a RIFF header", f);
+    std::fclose(f);
+    EXPECT_THROW(signalflow::WavReader(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+// Test SIMD pcm16_to_mono: vector paths equal the scalar conversion exactly
+TEST(SimdTest, Pcm16ToMonoMatchesScalar) {
+    using signalflow::simd::Level;
+    std::vector<int16_t> pcm(3 * 101);
+    for (size_t i = 0; i < pcm.size(); ++i) pcm[i] = static_cast<int16_t>((i * 7919) % 65536 - 32768);
+    for (size_t channels : {size_t(1), size_t(2), size_t(3)}) {
+        size_t frames = pcm.size() / channels;
+        std::vector<float> ref(frames), out(frames);
+        signalflow::simd::pcm16_to_mono(pcm.data(), channels, ref.data(), frames, Level::Scalar);
+        for (Level level : {Level::NEON, Level::AVX2, Level::AVX512}) {
+            if (!signalflow::simd::supported(level)) continue;
+            signalflow::simd::pcm16_to_mono(pcm.data(), channels, out.data(), frames, level);
+            EXPECT_EQ(out, ref) << signalflow::simd::name(level) << " channels " << channels;
+        }
+    }
+}
+
+// Compares a StaticMelPipeline with the constexpr helpers evaluated in constant expressions
+// (exactly) and with the runtime classes, which use <cmath> (to within float rounding)
+template <size_t NFFT, size_t Hop, size_t NMels, int SampleRate, float FMin, float FMax, signalflow::Window::Type Type>
+static void check_static_pipeline() {
+    using Pipeline = signalflow::StaticMelPipeline<NFFT, Hop, NMels, SampleRate, FMin, FMax, Type>;
+    using signalflow::MelFilterBank;
+    static constexpr auto window = [] {
+        std::array<float, NFFT> w{};
+        for (size_t i = 0; i < NFFT; ++i) w[i] = signalflow::Window::coefficient(i, NFFT, Type);
+        return w;
+    }();
+    static constexpr auto bins = [] {
+        constexpr auto key = MelFilterBank::normalize({NFFT, SampleRate, NMels, FMin, FMax});
+        std::array<int, NMels + 2> b{};
+        MelFilterBank::boundary_bins(NFFT, SampleRate, NMels, key.f_min, key.f_max, b.data());
+        return b;
+    }();
+
+    signalflow::Window runtime_window(NFFT, Type);
+    signalflow::CircularBuffer<float> ones(NFFT);
+    for (size_t i = 0; i < NFFT; ++i) ones.push(1.0f);
+    auto coeffs = runtime_window.apply(ones);
+    for (size_t i = 0; i < NFFT; ++i) {
+        EXPECT_EQ(Pipeline::window_coefficients()[i], window[i]);
+        EXPECT_FLOAT_EQ(Pipeline::window_coefficients()[i], coeffs[i]);
+    }
+
+    MelFilterBank mel_bank(NFFT, SampleRate, NMels, FMin, FMax);
+    for (size_t m = 0; m < NMels; ++m) {
+        auto actual = Pipeline::filter(m);
+        auto [first, length] = MelFilterBank::filter_support(bins[m], bins[m + 1], bins[m + 2], NFFT / 2 + 1);
+        EXPECT_EQ(actual.start_bin, first);
+        ASSERT_EQ(actual.weights.size(), length);
+        for (size_t j = 0; j < length; ++j) {
+            EXPECT_EQ(actual.weights[j], MelFilterBank::filter_weight(static_cast<int>(first + j), bins[m], bins[m + 1], bins[m + 2]));
+        }
+        auto runtime = mel_bank.filter(m);
+        EXPECT_EQ(actual.start_bin, runtime.start_bin);
+        ASSERT_EQ(actual.weights.size(), runtime.weights.size());
+        for (size_t j = 0; j < length; ++j) EXPECT_FLOAT_EQ(actual.weights[j], runtime.weights[j]);
+    }
+
+    // Streaming output matches MelSpectrogram frame for frame
+    std::vector<float> signal(NFFT * 8 + 123);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.05f * i) + 0.25f * std::sin(0.71f * i);
+    signalflow::MelSpectrogram runtime(NFFT, Hop, SampleRate, NMels, FMin, FMax, Type);
+    Pipeline fixed;
+    std::vector<float> a, b;
+    runtime.process(signal, [&](std::span<const float> mel) { a.insert(a.end(), mel.begin(), mel.end()); });
+    for (size_t offset = 0; offset < signal.size(); offset += 77) {
+        size_t count = std::min<size_t>(77, signal.size() - offset);
+        fixed.process(std::span<const float>(signal.data() + offset, count),
+            [&](std::span<const float> mel) { b.insert(b.end(), mel.begin(), mel.end()); });
+    }
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); ++i) EXPECT_NEAR(b[i], a[i], 1e-5f * (1.0f + std::abs(a[i])));
+}
+
+// Test StaticMelPipeline: compile-time tables are the constexpr path and agree with the runtime pipeline
+TEST(StaticMelPipelineTest, MatchesRuntimeClasses) {
+    check_static_pipeline<1024, 512, 40, 16000, 0.0f, 8000.0f, signalflow::Window::Type::Hann>();
+    check_static_pipeline<256, 100, 20, 8000, 100.0f, 4000.0f, signalflow::Window::Type::Hamming>();
+}
+
+// Test FFT plans: the Kiss plan reproduces kiss_fftr
+TEST(FFTPlanTest, KissMatchesKissFftr) {
+    for (size_t N : {2u, 6u, 64u, 100u, 512u}) {
+        std::vector<float> x(N);
+        for (size_t i = 0; i < N; ++i) x[i] = std::sin(0.37f * i) + 0.25f * std::cos(1.3f * i);
+
+        kiss_fftr_cfg cfg = kiss_fftr_alloc(static_cast<int>(N), 0, nullptr, nullptr);
+        std::vector<kiss_fft_cpx> expected(N / 2 + 1);
+        kiss_fftr(cfg, x.data(), expected.data());
+        free(cfg);
+
+        signalflow::FFT fft(N, signalflow::FFTBackend::Kiss);
+        std::vector<std::complex<float>> out(fft.num_bins());
+        fft.compute_complex(x, out);
+        for (size_t k = 0; k < out.size(); ++k) {
+            EXPECT_FLOAT_EQ(out[k].real(), expected[k].r);
+            EXPECT_FLOAT_EQ(out[k].imag(), expected[k].i);
+        }
+    }
+    EXPECT_THROW(signalflow::FFT(7), std::invalid_argument);
+}
+
+// Test FFT plans: Radix4 agrees with Kiss across sizes, including the small-size paths
+TEST(FFTPlanTest, Radix4MatchesKiss) {
+    for (size_t N = 2; N <= 4096; N *= 2) {
+        std::vector<float> x(N);
+        for (size_t i = 0; i < N; ++i) x[i] = std::sin(0.11f * i) + 0.5f * std::sin(2.7f * i + 1.0f);
+
+        signalflow::FFT kiss(N, signalflow::FFTBackend::Kiss);
+        signalflow::FFT radix(N, signalflow::FFTBackend::Radix4);
+        ASSERT_EQ(radix.backend(), signalflow::FFTBackend::Radix4);
+        std::vector<std::complex<float>> a(kiss.num_bins()), b(radix.num_bins());
+        kiss.compute_complex(x, a);
+        radix.compute_complex(x, b);
+        float tolerance = 1e-5f * N;
+        for (size_t k = 0; k < a.size(); ++k) {
+            EXPECT_NEAR(b[k].real(), a[k].real(), tolerance) << "N=" << N << " k=" << k;
+            EXPECT_NEAR(b[k].imag(), a[k].imag(), tolerance) << "N=" << N << " k=" << k;
+        }
+    }
+    EXPECT_THROW(signalflow::FFT(384, signalflow::FFTBackend::Radix4), std::invalid_argument);
+    EXPECT_EQ(signalflow::FFT(384, signalflow::FFTBackend::Auto).backend(), signalflow::FFTBackend::Kiss);
+    EXPECT_EQ(signalflow::FFT(512, signalflow::FFTBackend::Auto).backend(), signalflow::FFTBackend::Radix4);
+}
+
+// Test FFT plan cache: one plan per (size, backend), also under concurrent lookups
+TEST(FFTPlanTest, CacheSharesPlans) {
+    auto a = signalflow::fft_plan(1024, signalflow::FFTBackend::Radix4);
+    EXPECT_EQ(a, signalflow::fft_plan(1024, signalflow::FFTBackend::Auto));
+    EXPECT_NE(a, signalflow::fft_plan(1024, signalflow::FFTBackend::Kiss));
+
+    std::vector<std::shared_ptr<const signalflow::FFTPlan>> plans(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < plans.size(); ++t) {
+        threads.emplace_back([&plans, t] { plans[t] = signalflow::fft_plan(2048, signalflow::FFTBackend::Kiss); });
+    }
+    for (auto& thread : threads) thread.join();
+    for (auto& plan : plans) EXPECT_EQ(plan, plans[0]);
+}
+
+// Test FFT: compute_complex is consistent with compute_magnitude on every backend
+TEST(FFTTest, ComplexMatchesMagnitude) {
+    size_t N = 256;
+    std::vector<float> x(N);
+    for (size_t i = 0; i < N; ++i) x[i] = std::cos(0.05f * i * i / N);
+    for (auto backend : {signalflow::FFTBackend::Kiss, signalflow::FFTBackend::Radix4}) {
+        signalflow::FFT fft(N, backend);
+        std::vector<std::complex<float>> spectrum(fft.num_bins());
+        std::vector<float> mag(fft.num_bins());
+        fft.compute_complex(x, spectrum);
+        fft.compute_magnitude(x, mag);
+        for (size_t k = 0; k < mag.size(); ++k) EXPECT_NEAR(mag[k], std::abs(spectrum[k]), 1e-4f * (1.0f + mag[k]));
+    }
+}
+
+// Test SpscRing: power-of-two rounding, short writes when full, reads across the wrap
+TEST(SpscRingTest, WrapAndCapacity) {
+    signalflow::SpscRing<int> ring(6);
+    EXPECT_EQ(ring.capacity(), 8u);
+
+    std::vector<int> values = {1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(ring.write(values), 6u);
+    std::vector<int> out(4);
+    EXPECT_EQ(ring.read(out), 4u);
+    EXPECT_EQ(out, (std::vector<int>{1, 2, 3, 4}));
+
+    // 2 queued, 6 free: only 6 of 7 fit, and the data now wraps
+    EXPECT_EQ(ring.write(std::vector<int>{7, 8, 9, 10, 11, 12, 13}), 6u);
+    EXPECT_EQ(ring.available(), 8u);
+    EXPECT_EQ(ring.free_space(), 0u);
+    auto [first, second] = ring.readable();
+    EXPECT_EQ(first.size(), 4u);
+    EXPECT_EQ(second.size(), 4u);
+    EXPECT_EQ(first[0], 5);
+    EXPECT_EQ(second[3], 12);
+    ring.consume(3);
+
+    out.assign(8, 0);
+    EXPECT_EQ(ring.read(out), 5u);
+    EXPECT_EQ(out, (std::vector<int>{8, 9, 10, 11, 12, 0, 0, 0}));
+    EXPECT_EQ(ring.available(), 0u);
+    EXPECT_THROW(signalflow::SpscRing<int>(0), std::invalid_argument);
+}
+
+// Test SpscRing: a concurrent producer and consumer see every value once, in order
+TEST(SpscRingTest, ConcurrentStress) {
+    constexpr uint32_t kTotal = 2'000'000;
+    signalflow::SpscRing<uint32_t> ring(1024);
+
+    std::thread producer([&] {
+        std::vector<uint32_t> chunk(300);
+        uint32_t next = 0;
+        size_t size = 1;
+        while (next < kTotal) {
+            // Vary the chunk size so writes land on every wrap position
+            size = (size + 7) % chunk.size() + 1;
+            size_t n = std::min<size_t>(size, kTotal - next);
+            for (size_t i = 0; i < n; ++i) chunk[i] = next + static_cast<uint32_t>(i);
+            size_t written = ring.write(std::span<const uint32_t>(chunk.data(), n));
+            next += static_cast<uint32_t>(written);
+            if (written == 0) std::this_thread::yield();
+        }
+    });
+
+    std::vector<uint32_t> out(257);
+    uint32_t expected = 0;
+    bool in_order = true;
+    while (expected < kTotal) {
+        size_t n = ring.read(out);
+        for (size_t i = 0; i < n; ++i) in_order &= out[i] == expected++;
+        if (n == 0) std::this_thread::yield();
+    }
+    producer.join();
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(ring.available(), 0u);
+}
+
+// Test MelSpectrogram: consuming from an SpscRing fed by another thread matches span input
+TEST(MelSpectrogramTest, ConsumesSpscRing) {
+    std::vector<float> signal(16000);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.07f * i);
+
+    signalflow::MelSpectrogram reference(512, 160, 16000, 40);
+    std::vector<float> expected;
+    reference.process(signal, [&](std::span<const float> mel) { expected.insert(expected.end(), mel.begin(), mel.end()); });
+
+    signalflow::SpscRing<float> ring(1024);
+    std::thread producer([&] {
+        for (size_t offset = 0; offset < signal.size();) {
+            size_t n = std::min<size_t>(160, signal.size() - offset);
+            offset += ring.write(std::span<const float>(signal).subspan(offset, n));
+            std::this_thread::yield();
+        }
+    });
+
+    signalflow::MelSpectrogram spectrogram(512, 160, 16000, 40);
+    std::vector<float> got;
+    while (got.size() < expected.size()) {
+        spectrogram.process(ring, [&](std::span<const float> mel) { got.insert(got.end(), mel.begin(), mel.end()); });
+    }
+    producer.join();
+    EXPECT_EQ(got, expected);
+}
+
+// Test log_floor: close to std::log, identical on every compiled level, floor and NaN handling
+TEST(SimdTest, LogFloorMatchesStdLog) {
+    std::vector<float> in;
+    for (float x = 1e-30f; x < 1e30f; x *= 1.37f) in.push_back(x);
+    for (int i = 0; i < 1000; ++i) in.push_back(0.5f + i * 0.001f); // Around ln(x) = 0
+    in.push_back(0.0f);
+    in.push_back(-3.0f);
+    in.push_back(std::numeric_limits<float>::quiet_NaN());
+    in.push_back(std::numeric_limits<float>::infinity());
+
+    const float floor = 1e-20f;
+    std::vector<float> scalar(in.size());
+    signalflow::simd::log_floor(in.data(), scalar.data(), in.size(), floor, 1.0f, signalflow::simd::Level::Scalar);
+    for (size_t i = 0; i < in.size(); ++i) {
+        float x = std::isnan(in[i]) ? floor : std::clamp(in[i], floor, std::numeric_limits<float>::max());
+        double expected = std::log(static_cast<double>(x));
+        EXPECT_NEAR(scalar[i], expected, 2.5e-7 + 1.5 * std::abs(expected) * std::numeric_limits<float>::epsilon()) << "x=" << x;
+    }
+
+    for (auto level : {signalflow::simd::Level::NEON, signalflow::simd::Level::AVX2, signalflow::simd::Level::AVX512}) {
+        if (!signalflow::simd::supported(level)) continue;
+        std::vector<float> out(in.size());
+        signalflow::simd::log_floor(in.data(), out.data(), in.size(), floor, 1.0f, level);
+        EXPECT_EQ(out, scalar) << signalflow::simd::name(level);
+    }
+
+    // Scaled and in place
+    std::vector<float> db = {1.0f, 10.0f, 100.0f};
+    signalflow::simd::log_floor(db.data(), db.data(), db.size(), floor, 10.0f / std::numbers::ln10_v<float>);
+    EXPECT_NEAR(db[0], 0.0f, 1e-5f);
+    EXPECT_NEAR(db[1], 10.0f, 1e-5f);
+    EXPECT_NEAR(db[2], 20.0f, 1e-5f);
+}
+
+// Test LogMelStage: dB scaling, and the bias-corrected running normalization
+TEST(LogMelStageTest, ScaleAndNormalization) {
+    signalflow::LogMelOptions options;
+    options.scale = signalflow::LogMelOptions::Scale::Decibel;
+    options.spectrum = signalflow::LogMelOptions::Spectrum::Magnitude;
+    signalflow::LogMelStage db(2, options);
+    std::vector<float> frame = {10.0f, 0.0f};
+    db.apply(frame);
+    EXPECT_NEAR(frame[0], 20.0f, 1e-4f);
+    EXPECT_NEAR(frame[1], 20.0f * std::log10(options.floor), 1e-3f);
+
+    options = {};
+    options.normalize = true;
+    options.decay = 0.9f;
+    signalflow::LogMelStage stage(3, options);
+    double weight = 0.0, mean[3] = {}, var[3] = {};
+    for (int t = 0; t < 50; ++t) {
+        std::vector<float> mel = {1.0f + t, 0.5f + 0.1f * (t % 7), 100.0f * (t % 3 + 1)};
+        std::vector<float> logs = mel;
+        for (auto& v : logs) v = std::log(v);
+        stage.apply(mel);
+
+        weight = 0.9 * weight + 1.0;
+        for (int m = 0; m < 3; ++m) {
+            double delta = logs[m] - mean[m];
+            mean[m] += delta / weight;
+            var[m] = (1.0 - 1.0 / weight) * (var[m] + delta * delta / weight);
+            double expected = (logs[m] - mean[m]) / std::sqrt(var[m] + options.epsilon);
+            EXPECT_NEAR(mel[m], expected, 1e-3 * (1.0 + std::abs(expected))) << "t=" << t << " m=" << m;
+        }
+    }
+
+    stage.reset();
+    std::vector<float> first = {5.0f, 6.0f, 7.0f};
+    stage.apply(first);
+    EXPECT_EQ(first, std::vector<float>(3, 0.0f));
+
+    options.decay = 1.0f;
+    EXPECT_THROW(signalflow::LogMelStage(3, options), std::invalid_argument);
+}
+
+// Test MelSpectrogram: the fused log-mel stage equals power -> filterbank -> log by hand
+TEST(MelSpectrogramTest, LogMelStage) {
+    size_t n_fft = 512, hop = 256;
+    std::vector<float> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.03f * i) * (1.0f + 0.5f * std::sin(0.001f * i));
+
+    signalflow::LogMelOptions options;
+    signalflow::MelSpectrogram spectrogram(n_fft, hop, 16000, 40, 0.0f, 8000.0f,
+                                           signalflow::Window::Type::Hann, signalflow::FFTBackend::Kiss, options);
+    std::vector<float> got;
+    spectrogram.process(signal, [&](std::span<const float> mel) { got.insert(got.end(), mel.begin(), mel.end()); });
+
+    signalflow::Window window(n_fft);
+    signalflow::FFT fft(n_fft);
+    signalflow::MelFilterBank bank(n_fft, 16000, 40);
+    std::vector<float> windowed(n_fft), power(fft.num_bins()), mel(40), expected;
+    for (size_t start = 0; start + n_fft <= signal.size(); start += hop) {
+        window.apply(std::span<const float>(signal).subspan(start, n_fft), windowed);
+        fft.compute_power(windowed, power);
+        bank.apply(power, mel);
+        for (float v : mel) expected.push_back(std::log(std::max(v, options.floor)));
+    }
+    ASSERT_EQ(got.size(), expected.size());
+    for (size_t i = 0; i < got.size(); ++i) EXPECT_NEAR(got[i], expected[i], 1e-5f * (1.0f + std::abs(expected[i])));
+}
+
+// Test codec: float16 conversion round-trips every half and rounds like F16C
+TEST(CodecTest, HalfConversion) {
+    std::vector<uint16_t> halves(65536), back(65536);
+    for (size_t i = 0; i < halves.size(); ++i) halves[i] = static_cast<uint16_t>(i);
+    std::vector<float> floats(65536);
+    signalflow::codec::half_to_float(halves.data(), floats.data(), floats.size());
+    signalflow::codec::float_to_half(floats.data(), back.data(), back.size());
+    for (size_t i = 0; i < halves.size(); ++i) {
+        bool nan = (i & 0x7c00) == 0x7c00 && (i & 0x3ff);
+        // NaNs come back quiet; everything else exactly
+        EXPECT_EQ(back[i], nan ? (halves[i] | 0x200) : halves[i]) << "half=" << i;
+    }
+
+    // Ties to even, overflow, subnormals; 9 values so both the vector and scalar tail run
+    std::vector<float> in = {1.0f + 0x1p-11f, 1.0f + 3 * 0x1p-11f, 65519.0f, 65520.0f, -1e9f,
+                             0x1p-24f, 0x1p-25f, 3 * 0x1p-26f, -0.0f};
+    std::vector<uint16_t> expected = {0x3c00, 0x3c02, 0x7bff, 0x7c00, 0xfc00, 0x0001, 0x0000, 0x0001, 0x8000};
+    std::vector<uint16_t> out(in.size());
+    signalflow::codec::float_to_half(in.data(), out.data(), in.size());
+    EXPECT_EQ(out, expected);
+    signalflow::codec::float_to_half(in.data() + 8, out.data(), 1);
+    EXPECT_EQ(out[0], 0x8000);
+}
+
+// Test codec: min_max skips NaNs and is identical on every level, wherever the NaNs and
+// signed zeros fall relative to the vector lanes and the scalar tail
+TEST(CodecTest, MinMaxMatchesScalar) {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    for (size_t n : {0u, 1u, 7u, 8u, 9u, 16u, 40u, 83u}) {
+        std::vector<float> in(n);
+        for (size_t i = 0; i < n; ++i) in[i] = 4.0f * std::sin(0.37f * i + n);
+        for (size_t i = 0; i < n; i += 3) in[i] = nan;
+        if (n > 5) in[5] = -0.0f;
+
+        float lo, hi;
+        signalflow::codec::min_max(in.data(), n, lo, hi, signalflow::simd::Level::Scalar);
+        float expected_lo = std::numeric_limits<float>::infinity(), expected_hi = -expected_lo;
+        for (float v : in) {
+            if (std::isnan(v)) continue;
+            expected_lo = std::min(expected_lo, v);
+            expected_hi = std::max(expected_hi, v);
+        }
+        EXPECT_EQ(lo, expected_lo) << "n=" << n;
+        EXPECT_EQ(hi, expected_hi) << "n=" << n;
+
+        for (auto level : {signalflow::simd::Level::AVX2, signalflow::simd::Level::AVX512}) {
+            float vlo, vhi;
+            signalflow::codec::min_max(in.data(), n, vlo, vhi, level);
+            EXPECT_EQ(std::bit_cast<uint32_t>(vlo), std::bit_cast<uint32_t>(lo)) << "n=" << n;
+            EXPECT_EQ(std::bit_cast<uint32_t>(vhi), std::bit_cast<uint32_t>(hi)) << "n=" << n;
+        }
+    }
+
+    // All zeros of either sign come back as +0
+    std::vector<float> zeros = {-0.0f, 0.0f, -0.0f, -0.0f, 0.0f, -0.0f, -0.0f, -0.0f, 0.0f};
+    float lo, hi;
+    signalflow::codec::min_max(zeros.data(), zeros.size(), lo, hi);
+    EXPECT_FALSE(std::signbit(lo));
+    EXPECT_FALSE(std::signbit(hi));
+}
+
+// Test codec: every encoding round-trips MelSpectrogram output within its reported bound
+TEST(CodecTest, RoundTripMelFrames) {
+    std::vector<float> signal(16000);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.05f * i) * std::sin(0.0007f * i) + 0.01f * std::sin(1.3f * i);
+
+    signalflow::MelSpectrogram raw_spec(512, 160, 16000, 40);
+    signalflow::MelSpectrogram log_spec(512, 160, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+                                        signalflow::FFTBackend::Kiss, signalflow::LogMelOptions{});
+    std::vector<float> raw, logmel;
+    raw_spec.process(signal, [&](std::span<const float> mel) { raw.insert(raw.end(), mel.begin(), mel.end()); });
+    log_spec.process(signal, [&](std::span<const float> mel) { logmel.insert(logmel.end(), mel.begin(), mel.end()); });
+    const size_t frames = raw.size() / 40;
+    ASSERT_GT(frames, 10u);
+
+    for (auto encoding : {signalflow::MelEncoding::Float16, signalflow::MelEncoding::Int8, signalflow::MelEncoding::DeltaVarint}) {
+        for (const auto* features : {&raw, &logmel}) {
+            signalflow::MelCodec codec(40, encoding, 0.01f);
+            std::vector<uint8_t> bytes = {0xAB}; // encode() appends
+            auto stats = codec.encode(*features, bytes);
+            ASSERT_EQ(bytes.size(), 1 + stats.bytes);
+            EXPECT_LE(stats.bytes, codec.max_encoded_size(frames));
+            if (encoding != signalflow::MelEncoding::DeltaVarint) {
+                EXPECT_EQ(stats.bytes, codec.max_encoded_size(frames));
+            }
+
+            std::vector<float> decoded(features->size());
+            EXPECT_EQ(codec.decode(std::span<const uint8_t>(bytes).subspan(1), decoded), stats.bytes);
+            float max_error = 0.0f;
+            for (size_t i = 0; i < decoded.size(); ++i) max_error = std::max(max_error, std::abs(decoded[i] - (*features)[i]));
+            EXPECT_LE(max_error, stats.max_error) << "encoding=" << static_cast<int>(encoding);
+            EXPECT_GT(max_error, 0.0f);
+
+            // A truncated batch is rejected rather than decoded into garbage
+            EXPECT_THROW(codec.decode(std::span<const uint8_t>(bytes).subspan(1, stats.bytes - 1), decoded),
+                         std::invalid_argument);
+        }
+    }
+
+    // Smooth log-mel frames delta-code to well under 2 bytes per value
+    signalflow::MelCodec delta(40, signalflow::MelEncoding::DeltaVarint, 0.05f);
+    std::vector<uint8_t> bytes;
+    EXPECT_LT(delta.encode(logmel, bytes).bytes, logmel.size() * 2);
+
+    // A constant frame has zero range and decodes exactly
+    signalflow::MelCodec int8(40, signalflow::MelEncoding::Int8);
+    std::vector<float> flat(40, -3.25f), decoded(40);
+    bytes.clear();
+    EXPECT_EQ(int8.encode(flat, bytes).max_error, 0.0f);
+    int8.decode(bytes, decoded);
+    EXPECT_EQ(decoded, flat);
+
+    EXPECT_THROW(int8.encode(std::vector<float>(41), bytes), std::invalid_argument);
+    EXPECT_THROW(signalflow::MelCodec(40, signalflow::MelEncoding::DeltaVarint, 0.0f), std::invalid_argument);
+}
+
+// Test StreamEngine: each stream matches its own MelSpectrogram bit for bit, however
+// pushes and process() calls interleave, with ids reused after removal
+TEST(StreamEngineTest, MatchesIndependentChains) {
+    const size_t n_fft = 512, hop = 160, streams = 37;
+    signalflow::LogMelOptions options;
+    options.normalize = true;
+    signalflow::StreamEngine engine(n_fft, hop, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann, 3,
+                                    signalflow::FFTBackend::Kiss, options, 4096);
+
+    std::vector<std::vector<float>> signals(streams), got(streams), expected(streams);
+    std::vector<signalflow::StreamEngine::StreamId> ids;
+    for (size_t s = 0; s < streams; ++s) {
+        ids.push_back(engine.add_stream());
+        signals[s].resize(6000 + 97 * s);
+        for (size_t i = 0; i < signals[s].size(); ++i) signals[s][i] = std::sin((0.01f + 0.003f * s) * i);
+        signalflow::MelSpectrogram reference(n_fft, hop, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+                                             signalflow::FFTBackend::Kiss, options);
+        reference.process(signals[s], [&](std::span<const float> mel) {
+            expected[s].insert(expected[s].end(), mel.begin(), mel.end());
+        });
+    }
+    EXPECT_EQ(engine.stream_count(), streams);
+
+    std::vector<size_t> pos(streams, 0);
+    std::mutex mutex;
+    size_t total = 0;
+    for (size_t round = 0; ; ++round) {
+        bool pending = false;
+        for (size_t s = 0; s < streams; ++s) {
+            size_t chunk = std::min((round * 31 + s * 17) % 700 + 1, signals[s].size() - pos[s]);
+            pos[s] += engine.push(ids[s], std::span<const float>(signals[s]).subspan(pos[s], chunk));
+            pending |= pos[s] < signals[s].size();
+        }
+        total += engine.process([&](signalflow::StreamEngine::StreamId id, std::span<const float> mel) {
+            std::lock_guard lock(mutex);
+            got[id].insert(got[id].end(), mel.begin(), mel.end());
+        });
+        if (!pending) break;
+    }
+    size_t expected_total = 0;
+    for (size_t s = 0; s < streams; ++s) {
+        EXPECT_EQ(got[s], expected[s]) << "stream " << s;
+        EXPECT_LT(engine.queued(ids[s]), n_fft);
+        expected_total += expected[s].size() / 40;
+    }
+    EXPECT_EQ(total, expected_total);
+
+    engine.remove_stream(ids[5]);
+    EXPECT_THROW(engine.push(ids[5], signals[0]), std::out_of_range);
+    EXPECT_EQ(engine.add_stream(), ids[5]);
+    EXPECT_EQ(engine.queued(ids[5]), 0u);
+    EXPECT_GE(engine.stream_state_bytes(), 4096 * sizeof(float));
+}
+
+// Test StreamEngine: producers push concurrently with process() and no sample is lost
+TEST(StreamEngineTest, ConcurrentProducers) {
+    const size_t n_fft = 256, hop = 128, streams = 4, samples = 64000;
+    signalflow::StreamEngine engine(n_fft, hop, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann, 2);
+    std::vector<signalflow::StreamEngine::StreamId> ids;
+    for (size_t s = 0; s < streams; ++s) ids.push_back(engine.add_stream());
+
+    std::vector<float> signal(samples);
+    for (size_t i = 0; i < samples; ++i) signal[i] = std::sin(0.02f * i);
+    std::vector<std::thread> producers;
+    std::atomic<size_t> finished{0};
+    for (size_t s = 0; s < streams; ++s) {
+        producers.emplace_back([&, s] {
+            size_t pos = 0;
+            while (pos < samples) {
+                pos += engine.push(ids[s], std::span<const float>(signal).subspan(pos, std::min<size_t>(100 + s, samples - pos)));
+                std::this_thread::yield();
+            }
+            finished++;
+        });
+    }
+    std::vector<size_t> frames(streams, 0);
+    for (;;) {
+        bool done = finished.load() == streams; // Read before the final pass
+        engine.process([&](signalflow::StreamEngine::StreamId id, std::span<const float>) { frames[id]++; });
+        if (done) break;
+    }
+    for (auto& producer : producers) producer.join();
+    for (size_t s = 0; s < streams; ++s) EXPECT_EQ(frames[s], (samples - n_fft) / hop + 1);
+}
+
+// Test arena support: a whole pipeline fits in exactly required_bytes() of a fixed block
+// with no upstream allocator, and produces the same frames as the heap-allocated one
+TEST(ArenaTest, PipelineFitsRequiredBytes) {
+    std::vector<float> signal(8000);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.02f * i) + 0.3f * std::sin(0.9f * i);
+
+    for (auto backend : {signalflow::FFTBackend::Kiss, signalflow::FFTBackend::Radix4}) {
+        signalflow::LogMelOptions options;
+        options.normalize = true;
+        size_t bytes = signalflow::MelSpectrogram::required_bytes(512, 160, 16000, 40, 0.0f, 8000.0f,
+                                                                  signalflow::Window::Type::Hann, backend, options);
+        ASSERT_GT(bytes, 512 * sizeof(float));
+
+        signalflow::AlignedVector<std::byte> block(bytes);
+        std::pmr::monotonic_buffer_resource arena(block.data(), block.size(), std::pmr::null_memory_resource());
+        signalflow::MelSpectrogram in_arena(512, 160, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+                                            backend, options, &arena);
+        signalflow::MelSpectrogram on_heap(512, 160, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+                                           backend, options);
+        std::vector<float> got, expected;
+        in_arena.process(signal, [&](std::span<const float> mel) { got.insert(got.end(), mel.begin(), mel.end()); });
+        on_heap.process(signal, [&](std::span<const float> mel) { expected.insert(expected.end(), mel.begin(), mel.end()); });
+        EXPECT_EQ(got, expected);
+
+        // One byte less and construction fails instead of falling back to the heap. The
+        // smaller arena gets its own block: in_arena still lives in the first one.
+        signalflow::AlignedVector<std::byte> small_block(bytes - 1);
+        std::pmr::monotonic_buffer_resource small(small_block.data(), small_block.size(), std::pmr::null_memory_resource());
+        EXPECT_THROW(signalflow::MelSpectrogram(512, 160, 16000, 40, 0.0f, 8000.0f, signalflow::Window::Type::Hann,
+                                                backend, options, &small), std::bad_alloc);
+    }
+
+    // Individual classes take the same resource; storage is cache-line aligned either way
+    signalflow::ArenaSizer sizer;
+    signalflow::CircularBuffer<float> buffer(100, &sizer);
+    signalflow::SpscRing<float> ring(100, &sizer);
+    signalflow::Window window(256, signalflow::Window::Type::Hann, &sizer);
+    EXPECT_GE(sizer.bytes(), (100 + 128 + 256) * sizeof(float));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(buffer.segments().first.data()) % signalflow::kArenaAlignment, 0u);
+}
+
+// Test MelFilterPlan cache: one plan per normalized configuration; arena banks get their own
+TEST(MelFilterPlanTest, CacheSharesPlans) {
+    signalflow::MelFilterBank a(512, 16000, 40);
+    signalflow::MelFilterBank b(512, 16000, 40, 0.0f, 8000.0f);
+    EXPECT_EQ(a.plan(), b.plan());
+    // f_max above Nyquist is clamped, so this is the same configuration
+    signalflow::MelFilterBank clamped(512, 16000, 40, 0.0f, 20000.0f);
+    EXPECT_EQ(clamped.plan(), a.plan());
+    EXPECT_NE(signalflow::MelFilterBank(512, 16000, 64).plan(), a.plan());
+
+    signalflow::ArenaSizer sizer;
+    signalflow::MelFilterBank private_bank(512, 16000, 40, 0.0f, 8000.0f, &sizer);
+    EXPECT_NE(private_bank.plan(), a.plan());
+    EXPECT_GT(sizer.bytes(), a.plan()->weights().size() * sizeof(float));
+    EXPECT_TRUE(std::ranges::equal(private_bank.plan()->weights(), a.plan()->weights()));
+    EXPECT_TRUE(std::ranges::equal(private_bank.plan()->start_bins(), a.plan()->start_bins()));
+
+    EXPECT_THROW(signalflow::MelFilterBank(512, 0, 40), std::invalid_argument);
+}
+
+// Test edge cases: filters collapsed to one or two bins keep their peak, and no filter is
+// dead or reaches past the spectrum, including when f_max is above Nyquist
+TEST(MelFilterPlanTest, EveryFilterHasItsPeak) {
+    struct Config { size_t n_fft; int sample_rate; size_t n_mels; float f_max; };
+    for (auto config : {Config{64, 16000, 40, 8000.0f}, Config{128, 16000, 80, 8000.0f},
+                        Config{256, 8000, 40, 8000.0f}, Config{511, 16000, 20, 8000.0f}}) {
+        signalflow::MelFilterBank bank(config.n_fft, config.sample_rate, config.n_mels, 0.0f, config.f_max);
+        size_t n_bins = config.n_fft / 2 + 1;
+        for (size_t m = 0; m < bank.n_mels(); ++m) {
+            auto filter = bank.filter(m);
+            ASSERT_FALSE(filter.weights.empty()) << "n_fft " << config.n_fft << " filter " << m;
+            EXPECT_LE(filter.start_bin + filter.weights.size(), n_bins);
+            EXPECT_EQ(*std::max_element(filter.weights.begin(), filter.weights.end()), 1.0f);
+            for (float w : filter.weights) EXPECT_GT(w, 0.0f);
+        }
+        // A tone on any filter's peak bin shows up in that band
+        std::vector<float> mag(n_bins, 0.0f);
+        auto last = bank.filter(bank.n_mels() - 1);
+        mag[last.start_bin] = 1.0f;
+        EXPECT_GT(bank.apply(mag).back(), 0.0f);
+    }
+}
+
+// Test blob and header: serialized plans load back bit for bit, damage is rejected, and a
+// registered plan is what later banks use
+TEST(MelFilterPlanTest, BlobRoundTripAndRegistration) {
+    auto plan = signalflow::mel_filter_plan({1024, 16000, 80, 20.0f, 7600.0f});
+    auto blob = plan->serialize();
+    auto loaded = signalflow::MelFilterPlan::deserialize(blob);
+    EXPECT_EQ(loaded->key(), plan->key());
+    EXPECT_TRUE(std::ranges::equal(loaded->start_bins(), plan->start_bins()));
+    EXPECT_TRUE(std::ranges::equal(loaded->offsets(), plan->offsets()));
+    EXPECT_TRUE(std::ranges::equal(loaded->weights(), plan->weights()));
+
+    auto corrupt = blob;
+    corrupt[corrupt.size() / 2] ^= 0x40;
+    EXPECT_THROW(signalflow::MelFilterPlan::deserialize(corrupt), std::invalid_argument);
+    EXPECT_THROW(signalflow::MelFilterPlan::deserialize(std::span(blob).first(blob.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(signalflow::MelFilterPlan::deserialize(std::span(blob).first(3)), std::invalid_argument);
+
+    // Hand-made tables under a key no other test uses: banks pick them up from the cache
+    signalflow::MelPlanKey key{96, 12345, 2, 0.0f, 3000.0f};
+    std::vector<uint32_t> start_bins = {1, 4}, offsets = {0, 3, 5};
+    std::vector<float> weights = {0.25f, 1.0f, 0.5f, 1.0f, 0.75f};
+    signalflow::register_mel_filter_plan(std::make_shared<const signalflow::MelFilterPlan>(key, start_bins, offsets, weights));
+    signalflow::MelFilterBank bank(96, 12345, 2, 0.0f, 3000.0f);
+    EXPECT_EQ(bank.filter(1).start_bin, 4u);
+    EXPECT_TRUE(std::ranges::equal(bank.filter(0).weights, std::span(weights).first(3)));
+
+    // Tables that disagree with the key are refused
+    offsets = {0, 3, 4};
+    EXPECT_THROW(signalflow::MelFilterPlan(key, start_bins, offsets, weights), std::invalid_argument);
+    offsets = {0, 3, 5};
+    EXPECT_THROW(signalflow::MelFilterPlan({96, 12345, 2, 0.0f, 9000.0f}, start_bins, offsets, weights),
+                 std::invalid_argument);
+
+    // The generated header carries the key and every weight as an exact hex literal
+    std::string header = plan->header("mel_1024_80");
+    EXPECT_NE(header.find("namespace mel_1024_80"), std::string::npos);
+    EXPECT_NE(header.find("kWeights[" + std::to_string(plan->weights().size()) + "]"), std::string::npos);
+    EXPECT_NE(header.find("register_plan()"), std::string::npos);
+
+    EXPECT_THROW(signalflow::MelFilterBank(std::shared_ptr<const signalflow::MelFilterPlan>()), std::invalid_argument);
+}
+
+// Test the checked-in generated header (tests/mel_plan_512_40.hpp, the output of
+// header("mel_512_40") for this key): it compiles, its tables are exactly what
+// make_mel_filter_plan builds, and register_plan() puts it in front of the cache.
+// Regenerate it if the plan math changes.
+TEST(MelFilterPlanTest, GeneratedHeaderMatchesBuiltPlan) {
+    auto built = signalflow::make_mel_filter_plan(mel_512_40::kKey);
+    EXPECT_EQ(built->key(), mel_512_40::kKey);
+    EXPECT_TRUE(std::ranges::equal(built->start_bins(), mel_512_40::kStartBins));
+    EXPECT_TRUE(std::ranges::equal(built->offsets(), mel_512_40::kOffsets));
+    ASSERT_EQ(built->weights().size(), std::size(mel_512_40::kWeights));
+    for (size_t i = 0; i < built->weights().size(); ++i) {
+        EXPECT_EQ(std::bit_cast<uint32_t>(built->weights()[i]), std::bit_cast<uint32_t>(mel_512_40::kWeights[i])) << i;
+    }
+
+    mel_512_40::register_plan();
+    auto cached = signalflow::mel_filter_plan(mel_512_40::kKey);
+    EXPECT_EQ(cached->serialize(), built->serialize());
+    signalflow::MelFilterBank bank(512, 16000, 40);
+    EXPECT_EQ(bank.plan(), cached);
+}
+
+// Test feature files: both element types map back exactly, and bad files are refused
+TEST(FeatureFileTest, WriteAndMapRoundTrip) {
+    std::vector<float> signal(16000);
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.05f * i);
+    signalflow::MelSpectrogram spectrogram(512, 160, 16000, 40);
+    std::vector<float> values;
+    spectrogram.process(signal, [&](std::span<const float> mel) { values.insert(values.end(), mel.begin(), mel.end()); });
+
+    signalflow::FeatureFileHeader header;
+    header.frames = values.size() / 40;
+    header.n_mels = 40;
+    header.sample_rate = 16000;
+    header.n_fft = 512;
+    header.hop_size = 160;
+    header.f_max = 8000.0f;
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "sf_features.mel";
+
+    signalflow::write_feature_file(path.string(), header, values);
+    {
+        signalflow::FeatureFile file(path.string());
+        EXPECT_EQ(file.frames(), header.frames);
+        EXPECT_EQ(file.header().hop_size, 160u);
+        EXPECT_EQ(std::filesystem::file_size(path), 64 + values.size() * sizeof(float));
+        EXPECT_TRUE(std::ranges::equal(file.floats(), values));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(file.floats().data()) % 64, 0u);
+        EXPECT_THROW(file.halves(), std::logic_error);
+    }
+
+    // Fields are written one by one, little-endian: on such a host, the struct's own image
+    std::ifstream raw(path, std::ios::binary);
+    unsigned char bytes[64];
+    raw.read(reinterpret_cast<char*>(bytes), sizeof(bytes));
+    EXPECT_EQ(bytes[16], static_cast<unsigned char>(header.frames));
+    EXPECT_EQ(bytes[24], 40);
+    if constexpr (std::endian::native == std::endian::little) {
+        EXPECT_EQ(std::memcmp(bytes, &header, sizeof(bytes)), 0);
+    }
+    raw.close();
+
+    std::vector<uint16_t> halves(values.size());
+    signalflow::codec::float_to_half(values.data(), halves.data(), values.size());
+    header.type = signalflow::FeatureType::Float16;
+    EXPECT_THROW(signalflow::write_feature_file(path.string(), header, values), std::invalid_argument);
+    signalflow::write_feature_file(path.string(), header, halves);
+    {
+        signalflow::FeatureFile file(path.string());
+        EXPECT_TRUE(std::ranges::equal(file.halves(), halves));
+        std::vector<float> row(40), expected(40);
+        file.row(7, row);
+        signalflow::codec::half_to_float(halves.data() + 7 * 40, expected.data(), 40);
+        EXPECT_EQ(row, expected);
+    }
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 2);
+    EXPECT_THROW(signalflow::FeatureFile(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+
+    // Concurrent writers of one path each use their own temporary; one complete file wins
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "sf_features_race";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+    path = directory / "race.mel";
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 20; ++i) signalflow::write_feature_file(path.string(), header, halves);
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    EXPECT_TRUE(std::ranges::equal(signalflow::FeatureFile(path.string()).halves(), halves));
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+    std::filesystem::remove_all(directory);
+}
+
+// Test FeatureFileWriter: rows appended in pieces give the same file as one
+// write_feature_file call, and an uncommitted writer leaves nothing behind
+TEST(FeatureFileTest, WriterAppendsRows) {
+    std::vector<float> values(40 * 25);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = std::sin(0.01f * i) * 100.0f;
+    std::vector<uint16_t> halves(values.size());
+    signalflow::codec::float_to_half(values.data(), halves.data(), values.size());
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "sf_features_writer";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directory(directory);
+    auto read_bytes = [](const std::filesystem::path& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+
+    for (auto type : {signalflow::FeatureType::Float32, signalflow::FeatureType::Float16}) {
+        signalflow::FeatureFileHeader header;
+        header.type = type;
+        header.n_mels = 40;
+        header.frames = 25;
+        header.sample_rate = 16000;
+        if (type == signalflow::FeatureType::Float32) {
+            signalflow::write_feature_file((directory / "whole.mel").string(), header, values);
+        } else {
+            signalflow::write_feature_file((directory / "whole.mel").string(), header, halves);
+        }
+
+        header.frames = 0;
+        std::filesystem::remove(directory / "pieces.mel");
+        signalflow::FeatureFileWriter writer((directory / "pieces.mel").string(), header);
+        std::span<const float> rows(values);
+        writer.append(rows.first(40 * 7));
+        writer.append(rows.subspan(40 * 7, 0));
+        writer.append(rows.subspan(40 * 7));
+        EXPECT_THROW(writer.append(rows.first(39)), std::invalid_argument);
+        EXPECT_EQ(writer.frames(), 25u);
+        EXPECT_FALSE(std::filesystem::exists(directory / "pieces.mel"));
+        writer.commit();
+        EXPECT_EQ(read_bytes(directory / "pieces.mel"), read_bytes(directory / "whole.mel"));
+    }
+
+    {
+        signalflow::FeatureFileHeader header;
+        header.n_mels = 40;
+        signalflow::FeatureFileWriter abandoned((directory / "abandoned.mel").string(), header);
+        abandoned.append(values);
+        EXPECT_THROW(abandoned.append(halves), std::invalid_argument);
+    }
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 2);
+    std::filesystem::remove_all(directory);
+}